@@ -0,0 +1,267 @@
+/**
+ *  \brief
+ *
+ *  Copyright (C) 2017  Chaos-Dev
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "Actor.h"
+#include "ActorGrid.h"
+#include "ActorStore.h"
+#include "Pool.h"
+
+/** Compares an array of actor pointers with the ActorStore at 10k actors.
+ *
+ *  The pointer layout is the one the engine had before the store: every
+ *  actor is allocated on its own, in no particular order, and each tile
+ *  keeps a list of pointers to the actors on it.  The store keeps the same
+ *  fields in arrays indexed by entity, with the monsters in a sparse set.
+ *
+ *  Three things are timed, as the engine does them:
+ *  - the turn loop, where each monster near the player checks the eight
+ *    tiles around it for blockers, as it does when picking a step;
+ *  - gathering the monsters' positions and stats for the threat pass;
+ *  - drawing a screenful of tiles around a moving camera.
+ *  Both layouts must give the same answers.
+ */
+
+static const int MAP_WIDTH = 800;
+static const int MAP_HEIGHT = 500;
+static const int NUM_ROCKS = 8000;
+static const int NUM_MONSTERS = 1500;
+static const int NUM_ITEMS = 500;
+static const int VIEW_WIDTH = 80;    // Tiles on screen
+static const int VIEW_HEIGHT = 50;
+static const int ACTIVE_RANGE = 60;  // As in the engine's turn loop
+
+class BenchAi final : public Ai {
+ public:
+  BenchAi() : Ai(MONSTER) {};
+  void Update(Actor* owner) {};
+  void ProcessInput(Actor* owner, int key, bool shift) {};
+  bool isActive(Actor* owner) { return true; };
+};
+
+struct Spawn {
+  int x, y;
+  Actor::RenderLayer layer;
+};
+
+/** The layout before the store.
+ */
+struct PointerLayout {
+  std::vector<Actor*> actors;
+  std::vector<std::vector<Actor*>> tiles;  // In drawing order
+
+  PointerLayout() : tiles(MAP_WIDTH*MAP_HEIGHT) {};
+  bool CanWalk(int x, int y) const {
+    if (x < 0 || x >= MAP_WIDTH || y < 0 || y >= MAP_HEIGHT) return true;
+    for (const Actor* actor : tiles[x + y*MAP_WIDTH]) {
+      if (actor->blocks) return false;
+    }
+    return true;
+  };
+};
+
+template <typename F>
+static double Time(int runs, F run) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i=0; i<runs; i++) run(i);
+  std::chrono::duration<double, std::micro> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count()/runs;
+}
+
+int main() {
+  std::mt19937 rng(1234);
+  std::uniform_int_distribution<> random_x(0, MAP_WIDTH-1);
+  std::uniform_int_distribution<> random_y(0, MAP_HEIGHT-1);
+  std::uniform_int_distribution<> random_stat(0, 20);
+  std::vector<Spawn> spawns;
+  for (int i=0; i<NUM_ROCKS; i++)
+    spawns.push_back({random_x(rng), random_y(rng), Actor::PROPS});
+  for (int i=0; i<NUM_MONSTERS; i++)
+    spawns.push_back({random_x(rng), random_y(rng), Actor::CREATURES});
+  for (int i=0; i<NUM_ITEMS; i++)
+    spawns.push_back({random_x(rng), random_y(rng), Actor::ITEMS});
+  std::shuffle(spawns.begin(), spawns.end(), rng);
+  std::vector<Stats> stats;
+  for (unsigned int i=0; i<spawns.size(); i++) {
+    stats.push_back({0, random_stat(rng), random_stat(rng), 3,
+                     random_stat(rng)});
+  }
+  const int turns = 200;
+  std::vector<int> player_x, camera_x, camera_y;
+  for (int i=0; i<turns; i++) {
+    player_x.push_back(random_x(rng));
+    camera_x.push_back(random_x(rng));
+    camera_y.push_back(random_y(rng));
+  }
+
+  BenchAi ai;
+  auto create = [&](const Spawn& spawn, int i, Pool* pool) {
+    Color color(spawn.layer*40, i % 256, 100);
+    int symbol = (spawn.layer == Actor::PROPS ? '*' : 'a' + i % 26);
+    Actor* actor = pool ? pool->New<Actor>(spawn.x, spawn.y, symbol, color, 1)
+                        : new Actor(spawn.x, spawn.y, symbol, color, 1);
+    actor->blocks = (spawn.layer != Actor::ITEMS);
+    actor->render_layer = spawn.layer;
+    if (spawn.layer == Actor::CREATURES) {
+      actor->ai = &ai;
+      actor->stats = pool ? pool->New<Stats>(stats[i]) : new Stats(stats[i]);
+    }
+    return actor;
+  };
+
+  // The pointer layout, with the tile lists in drawing order.
+  PointerLayout aos;
+  for (unsigned int i=0; i<spawns.size(); i++)
+    aos.actors.push_back(create(spawns[i], i, nullptr));
+  for (int layer=0; layer<Actor::NUM_RENDER_LAYERS; layer++) {
+    for (Actor* actor : aos.actors) {
+      if (actor->render_layer == layer)
+        aos.tiles[actor->x + actor->y*MAP_WIDTH].push_back(actor);
+    }
+  }
+
+  // The store
+  Pool pool;
+  ActorStore store(MAP_WIDTH, MAP_HEIGHT);
+  ActorGrid grid(MAP_WIDTH, MAP_HEIGHT);
+  for (unsigned int i=0; i<spawns.size(); i++) {
+    Actor* actor = create(spawns[i], i, &pool);
+    actor->entity = store.Add(actor, actor->stats ? *actor->stats : Stats{});
+  }
+  grid.Update(store, 0);
+
+  long aos_free = 0, aos_threat = 0, aos_drawn = 0;
+  long soa_free = 0, soa_threat = 0, soa_drawn = 0;
+
+  double aos_turn = Time(turns, [&](int turn) {
+    int px = player_x[turn];
+    for (Actor* actor : aos.actors) {
+      if (!actor->ai || actor->ai->type != Ai::MONSTER) continue;
+      if (std::abs(actor->x - px) >= ACTIVE_RANGE) continue;
+      for (int dy=-1; dy<=1; dy++) {
+        for (int dx=-1; dx<=1; dx++) {
+          if ((dx || dy) && aos.CanWalk(actor->x + dx, actor->y + dy))
+            aos_free++;
+        }
+      }
+    }
+  });
+  double soa_turn = Time(turns, [&](int turn) {
+    int px = player_x[turn];
+    for (int i=0; i<store.ai.Size(); i++) {
+      int monster = store.ai[i];
+      int x = store.x[monster], y = store.y[monster];
+      if (std::abs(x - px) >= ACTIVE_RANGE) continue;
+      for (int dy=-1; dy<=1; dy++) {
+        for (int dx=-1; dx<=1; dx++) {
+          if ((dx || dy) && store.CanWalk(x + dx, y + dy)) soa_free++;
+        }
+      }
+    }
+  });
+
+  std::vector<int16_t> positions;
+  std::vector<int> attack, max_range;
+  double aos_gather = Time(turns, [&](int turn) {
+    positions.clear(); attack.clear(); max_range.clear();
+    for (Actor* actor : aos.actors) {
+      if (!actor->ai || actor->ai->type != Ai::MONSTER) continue;
+      positions.push_back(actor->x);
+      positions.push_back(actor->y);
+      attack.push_back(actor->stats->attack);
+      max_range.push_back(actor->stats->max_range);
+    }
+    aos_threat += attack.size();
+    for (unsigned int i=0; i<attack.size(); i++)
+      aos_threat += attack[i]*max_range[i] + positions[2*i];
+  });
+  double soa_gather = Time(turns, [&](int turn) {
+    positions.clear(); attack.clear(); max_range.clear();
+    for (int i=0; i<store.ai.Size(); i++) {
+      int monster = store.ai[i];
+      positions.push_back(store.x[monster]);
+      positions.push_back(store.y[monster]);
+      attack.push_back(store.attack[monster]);
+      max_range.push_back(store.max_range[monster]);
+    }
+    soa_threat += attack.size();
+    for (unsigned int i=0; i<attack.size(); i++)
+      soa_threat += attack[i]*max_range[i] + positions[2*i];
+  });
+
+  // A colour change and a put per actor drawn, as in RenderActors.
+  double aos_render = Time(turns, [&](int turn) {
+    int x0 = camera_x[turn] - VIEW_WIDTH/2, y0 = camera_y[turn] - VIEW_HEIGHT/2;
+    for (int y=std::max(y0, 0); y<std::min(y0 + VIEW_HEIGHT, MAP_HEIGHT); y++) {
+      for (int x=std::max(x0, 0); x<std::min(x0 + VIEW_WIDTH, MAP_WIDTH); x++) {
+        for (const Actor* actor : aos.tiles[x + y*MAP_WIDTH]) {
+          aos_drawn += (actor->x - x0) + (actor->y - y0) + actor->symbol +
+                       (actor->color.Convert() & 0xFF);
+        }
+      }
+    }
+  });
+  std::vector<int> visible;
+  double soa_render = Time(turns, [&](int turn) {
+    int x0 = camera_x[turn] - VIEW_WIDTH/2, y0 = camera_y[turn] - VIEW_HEIGHT/2;
+    grid.GetEntitiesIn(x0, y0, x0 + VIEW_WIDTH, y0 + VIEW_HEIGHT, visible);
+    for (int entity : visible) {
+      soa_drawn += (store.x[entity] - x0) + (store.y[entity] - y0) +
+                   store.symbol[entity] + (store.color[entity] & 0xFF);
+    }
+  });
+  // The lists are rebuilt once per turn after the monsters have moved.
+  double soa_rebuild = Time(turns, [&](int turn) {
+    grid.Update(store, turn + 1);
+  });
+
+  std::printf("%d actors, %d of them monsters, on a %dx%d map\n",
+              NUM_ROCKS + NUM_MONSTERS + NUM_ITEMS, NUM_MONSTERS, MAP_WIDTH,
+              MAP_HEIGHT);
+  std::printf("%-28s %13s %12s %9s\n", "per turn", "pointers (us)",
+              "store (us)", "speedup");
+  std::printf("%-28s %13.1f %12.1f %8.1fx\n", "turn loop", aos_turn,
+              soa_turn, aos_turn/soa_turn);
+  std::printf("%-28s %13.1f %12.1f %8.1fx\n", "threat gather", aos_gather,
+              soa_gather, aos_gather/soa_gather);
+  std::printf("%-28s %13.1f %12.1f %8.1fx\n", "render a screen", aos_render,
+              soa_render, aos_render/soa_render);
+  std::printf("%-28s %13s %12.1f\n", "rebuild the tile lists", "-",
+              soa_rebuild);
+
+  for (Actor* actor : aos.actors) {
+    delete actor->stats;
+    delete actor;
+  }
+  if (aos_free != soa_free || aos_threat != soa_threat ||
+      aos_drawn != soa_drawn) {
+    std::printf("The layouts disagree: %ld/%ld free tiles, %ld/%ld threats, "
+                "%ld/%ld drawn\n", aos_free, soa_free, aos_threat, soa_threat,
+                aos_drawn, soa_drawn);
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,110 @@
+/**
+ *  \brief
+ *
+ *  Copyright (C) 2017  Chaos-Dev
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Color.h"
+#include "PackedColor.h"
+
+/** Times blending the colours of a whole 800x500 level.
+ *
+ *  The old way blends Color structs, three ints scaled by a float per
+ *  channel, as Map::Init did for the water.  The current way packs the
+ *  colours into 32 bits and blends whole arrays with PackedColor.  The
+ *  aiming overlay, which mixes a little white into every tile, is timed
+ *  the same way.
+ */
+
+static const int WIDTH = 800;
+static const int HEIGHT = 500;
+
+template <typename F>
+static double TimeRuns(int runs, F run) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i=0; i<runs; i++) run();
+  std::chrono::duration<double, std::milli> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count()/runs;
+}
+
+int main() {
+  const int n = WIDTH*HEIGHT;
+  const int runs = 50;
+  Color water(30, 100, 200), beach(200, 180, 120), white(255, 255, 255);
+  std::mt19937 rng(1234);
+  std::uniform_real_distribution<float> random_fraction(0, 1);
+  std::vector<float> fractions(n);
+  for (float& fraction : fractions) fraction = random_fraction(rng);
+
+  // The old way
+  std::vector<Color> old_colors(n);
+  std::vector<color_t> old_packed(n);
+  double old_lerp = TimeRuns(runs, [&] {
+    for (int i=0; i<n; i++) {
+      old_colors[i] = water*fractions[i] + beach*(1.0f - fractions[i]);
+      old_packed[i] = old_colors[i].Convert();
+    }
+  });
+  double old_mix = TimeRuns(runs, [&] {
+    for (int i=0; i<n; i++)
+      old_packed[i] = (old_colors[i]*0.9f + white*0.1f).Convert();
+  });
+
+  // The current way
+  std::vector<uint16_t> weights(n);
+  std::vector<color_t> colors(n), mixed(n);
+  color_t packed_water = PackedColor::Pack(water);
+  color_t packed_beach = PackedColor::Pack(beach);
+  double new_lerp = TimeRuns(runs, [&] {
+    for (int i=0; i<n; i++) weights[i] = PackedColor::Weight(fractions[i]);
+    std::fill(colors.begin(), colors.end(), packed_beach);
+    PackedColor::Lerp(colors.data(), packed_water, weights.data(),
+                      colors.data(), n);
+  });
+  double new_mix = TimeRuns(runs, [&] {
+    PackedColor::Mix(colors.data(), 0xFFFFFFFF, 26, mixed.data(), n);
+  });
+
+  // Both ways should come out within rounding of each other.
+  int far_off = 0;
+  for (int i=0; i<n; i++) {
+    for (int shift=0; shift<24; shift+=8) {
+      int a = (old_packed[i] >> shift) & 0xFF;
+      int b = (mixed[i] >> shift) & 0xFF;
+      if (a - b > 3 || b - a > 3) far_off++;
+    }
+  }
+
+  std::printf("%dx%d tiles, per pass\n", WIDTH, HEIGHT);
+  std::printf("%-16s %10s %14s %9s\n", "", "old (ms)", "current (ms)",
+              "speedup");
+  std::printf("%-16s %10.2f %14.2f %8.1fx\n", "water blend", old_lerp,
+              new_lerp, old_lerp/new_lerp);
+  std::printf("%-16s %10.2f %14.2f %8.1fx\n", "aiming overlay", old_mix,
+              new_mix, old_mix/new_mix);
+  if (far_off > 0) {
+    std::printf("%d channels differ by more than rounding\n", far_off);
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,175 @@
+/**
+ *  \brief
+ *
+ *  Copyright (C) 2017  Chaos-Dev
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#include "ColorRuns.h"
+
+/** Counts the draw calls Map::Render makes for a frame, before and after.
+ *
+ *  The old renderer called terminal_put_ext once for every cell of the map
+ *  panel.  The current one fills each run of same-coloured tiles with one
+ *  terminal_clear_area and only puts the water a cell at a time.  The
+ *  level is a stand-in for River: an 800x500 map with a winding river of
+ *  changing width, beaches along the banks and a background beyond them.
+ *  Frames are counted with the camera following the river, for the game's
+ *  map panel and for a panel showing the whole level, with and without the
+ *  aiming range splitting the runs.
+ */
+
+static const int WIDTH = 800;
+static const int HEIGHT = 500;
+static const float pi = 3.14159265;
+
+struct Count {
+  long puts, spans;
+};
+
+// Walks the visible runs the way Map::Render does, counting instead of
+// drawing.  A tile is two cells wide.
+static Count CountFrame(const ColorRuns& color_runs, int panel_width,
+                        int panel_height, int camera_x, int camera_y,
+                        int range) {
+  Count count = {0, 0};
+  int x_offset = camera_x - panel_width/4;
+  int x_min = std::max(0, x_offset);
+  int x_max = std::min(WIDTH, (panel_width-1)/2 + x_offset + 1);
+  for (int term_y=0; term_y<panel_height; term_y++) {
+    int game_y = HEIGHT - (term_y + HEIGHT-camera_y - panel_height/2);
+    if (game_y < 0 || game_y >= HEIGHT || x_min >= x_max) continue;
+    int aim_start = 0, aim_end = 0;
+    int dy = std::abs(game_y - camera_y);
+    if (dy <= range) {
+      int half_width = (int)std::sqrt(float(range*range - dy*dy));
+      aim_start = camera_x - half_width;
+      aim_end = camera_x + half_width + 1;
+    }
+    const ColorRun* run = color_runs.Find(game_y, x_min);
+    const ColorRun* row_end = color_runs.RowEnd(game_y);
+    for (; run != row_end && run->start < x_max; ++run) {
+      int start = std::max(run->start, x_min);
+      int end = std::min(run->end, x_max);
+      if (run->water) {
+        for (int game_x=start; game_x<end; game_x++) {
+          for (int i=0; i<2; i++) {
+            int term_x = (game_x - x_offset)*2 + i;
+            if (term_x >= 0 && term_x < panel_width) count.puts++;
+          }
+        }
+        continue;
+      }
+      while (start < end) {
+        bool in_range = (start >= aim_start && start < aim_end);
+        int span_end = in_range ? aim_end : (start < aim_start ? aim_start : end);
+        start = std::min(span_end, end);
+        count.spans++;
+      }
+    }
+  }
+  return count;
+}
+
+// The old renderer put every cell of the panel that was on the map.
+static long CountOldFrame(int panel_width, int panel_height, int camera_x,
+                          int camera_y) {
+  long puts = 0;
+  for (int term_x=0; term_x<panel_width; term_x++) {
+    for (int term_y=0; term_y<panel_height; term_y++) {
+      int game_x = term_x/2 + camera_x - panel_width/4;
+      int game_y = HEIGHT - (term_y + HEIGHT-camera_y - panel_height/2);
+      if (game_x >= 0 && game_x < WIDTH && game_y >= 0 && game_y < HEIGHT)
+        puts++;
+    }
+  }
+  return puts;
+}
+
+static float Shape(int x) {
+  return HEIGHT/2 + 60*std::sin(2*pi*x/230) + 20*std::sin(2*pi*x/97);
+}
+
+int main() {
+  const color_t water_color = 0xFF1E64C8, beach = 0xFFC8B478;
+  const color_t edge = 0xFF64643C, bg = 0xFF008000;
+  std::vector<color_t> colors(WIDTH*HEIGHT);
+  std::vector<bool> water(WIDTH*HEIGHT);
+  long water_tiles = 0;
+  for (int x=0; x<WIDTH; x++) {
+    float half_width = 0.5*(27.5 + 12.5*std::sin(2*pi*x/170));
+    for (int y=0; y<HEIGHT; y++) {
+      float rescaled = std::abs(y - Shape(x))/half_width;
+      float above = std::abs(y + 1 - Shape(x))/half_width;
+      float below = std::abs(y - 1 - Shape(x))/half_width;
+      color_t& color = colors[x + y*WIDTH];
+      if (rescaled < 1.0) {
+        // The current is fastest in the middle, and every tile differs.
+        int speed = int(200*(1 - rescaled*rescaled)) + (x + y)%8;
+        color = water_color + speed;
+        water[x + y*WIDTH] = true;
+        water_tiles++;
+      } else if (rescaled < 1.2) {
+        color = beach;
+      } else if ((above > 1.0 && above < 1.2) || (below > 1.0 && below < 1.2)) {
+        color = edge;
+      } else {
+        color = bg;
+      }
+    }
+  }
+  ColorRuns color_runs;
+  color_runs.Build(colors, water, WIDTH, HEIGHT);
+  std::printf("%dx%d level, %ld water tiles, %d runs\n", WIDTH, HEIGHT,
+              water_tiles, color_runs.Count());
+
+  struct Viewport {
+    const char* name;
+    int width, height;
+  };
+  // The game's map panel is the 132x43 window less the 40 cell sidebar.
+  const Viewport viewports[] = {{"map panel", 92, 43},
+                                {"whole level", 2*WIDTH, HEIGHT}};
+  std::printf("%-12s %-6s %12s %12s %12s %9s\n", "viewport", "aiming",
+              "old puts", "puts", "spans", "fewer");
+  for (const Viewport& viewport : viewports) {
+    for (int range : {-1, 10}) {
+      long old_calls = 0, puts = 0, spans = 0;
+      int frames = 0;
+      for (int x=viewport.width/4; x<=WIDTH - viewport.width/4; x+=10) {
+        int camera_x = (viewport.width >= 2*WIDTH) ? WIDTH/2 : x;
+        int camera_y = (viewport.height >= HEIGHT) ? HEIGHT/2 : Shape(x);
+        old_calls += CountOldFrame(viewport.width, viewport.height,
+                                   camera_x, camera_y);
+        Count count = CountFrame(color_runs, viewport.width, viewport.height,
+                                 camera_x, camera_y, range);
+        puts += count.puts;
+        spans += count.spans;
+        frames++;
+      }
+      std::printf("%-12s %-6s %12.0f %12.0f %12.0f %8.1fx\n", viewport.name,
+                  range < 0 ? "no" : "yes", double(old_calls)/frames,
+                  double(puts)/frames, double(spans)/frames,
+                  double(old_calls)/(puts + spans));
+    }
+  }
+  return 0;
+}
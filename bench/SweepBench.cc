@@ -0,0 +1,157 @@
+/**
+ *  \brief
+ *
+ *  Copyright (C) 2017  Chaos-Dev
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "GridLine.h"
+
+/** Times sweeping raft moves against the rocks of an 800x500 level.
+ *
+ *  The old way is PlayerAi::CheckRaftDamage as it was: eight float steps
+ *  along the move, rounding to a tile each time, with Map::isRock
+ *  searching the list of rocks.  Bresenham is the integer line that
+ *  replaced it, and the current way is the supercover walk, both checking
+ *  the rock flag on the tiles.  The float steps are capped at eight here;
+ *  the old loop waited for the position to come within 1e-3 of the end,
+ *  which it could miss and then run forever.  The rocks each way hits are
+ *  counted, to show how many the others slip past.
+ */
+
+struct Rock {
+  int x, y;
+  int width;
+};
+
+static const int WIDTH = 800;
+static const int HEIGHT = 500;
+
+template <typename F>
+static double TimeRuns(int runs, F run) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i=0; i<runs; i++) run();
+  std::chrono::duration<double, std::milli> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count()/runs;
+}
+
+struct Move {
+  int x0, y0, x1, y1;
+};
+
+int main() {
+  std::mt19937 rng(27);
+  std::vector<Rock> rocks;
+  std::vector<bool> is_rock(WIDTH*HEIGHT);
+  std::uniform_int_distribution<int> rock_x(0, WIDTH - 1);
+  std::normal_distribution<float> rock_y(HEIGHT/2, HEIGHT/16);
+  for (int i=0; i<400; i++) {
+    Rock rock = {rock_x(rng), int(rock_y(rng)), 1 + i%2};
+    rocks.push_back(rock);
+    for (int y=rock.y; y<rock.y + rock.width; y++) {
+      is_rock[rock.x + y*WIDTH] = true;
+    }
+  }
+  auto isRockOld = [&](int x, int y) {
+    for (const Rock& rock : rocks) {
+      if (rock.x == x && rock.y == y) return true;
+      if (rock.x == x && rock.y+1 == y && rock.width == 2) return true;
+    }
+    return false;
+  };
+  auto isRock = [&](int x, int y) {
+    if (x < 0 || x >= WIDTH || y < 0 || y >= HEIGHT) return false;
+    return bool(is_rock[x + y*WIDTH]);
+  };
+
+  const int moves_per_speed = 20000, runs = 5;
+  std::printf("%d moves per speed, ms per pass (rocks hit)\n",
+              moves_per_speed);
+  std::printf("%-7s %18s %18s %18s\n", "speed", "old", "bresenham",
+              "supercover");
+  for (int speed : {1, 4, 16, 64}) {
+    std::vector<Move> moves(moves_per_speed);
+    std::uniform_int_distribution<int> step(-speed, speed);
+    std::normal_distribution<float> start_y(HEIGHT/2, HEIGHT/12);
+    for (Move& move : moves) {
+      move.x0 = rock_x(rng);
+      move.y0 = std::min(std::max(int(start_y(rng)), 0), HEIGHT - 1);
+      move.x1 = move.x0 + step(rng);
+      move.y1 = move.y0 + step(rng);
+    }
+
+    long old_hits = 0;
+    double old_time = TimeRuns(runs, [&] {
+      old_hits = 0;
+      for (const Move& move : moves) {
+        float dx = move.x1 - move.x0, dy = move.y1 - move.y0;
+        float distance = std::sqrt(dx*dx + dy*dy);
+        if (distance == 0) continue;
+        float x = move.x0, y = move.y0;
+        int temp_x = move.x0, temp_y = move.y0;
+        for (int i=0; i<8; i++) {
+          x += dx/8; y += dy/8;
+          if (std::round(x) != temp_x || std::round(y) != temp_y) {
+            temp_x = std::round(x); temp_y = std::round(y);
+            if (isRockOld(temp_x, temp_y)) old_hits++;
+          }
+        }
+      }
+    });
+
+    long bresenham_hits = 0;
+    double bresenham_time = TimeRuns(runs, [&] {
+      bresenham_hits = 0;
+      for (const Move& move : moves) {
+        int x0 = move.x0, y0 = move.y0;
+        int dx = std::abs(move.x1 - x0), sx = (x0 < move.x1 ? 1 : -1);
+        int dy = -std::abs(move.y1 - y0), sy = (y0 < move.y1 ? 1 : -1);
+        int err = dx + dy;
+        while (x0 != move.x1 || y0 != move.y1) {
+          int e2 = 2*err;
+          if (e2 >= dy) { err += dy; x0 += sx; }
+          if (e2 <= dx) { err += dx; y0 += sy; }
+          if (isRock(x0, y0)) bresenham_hits++;
+        }
+      }
+    });
+
+    long hits = 0;
+    double time = TimeRuns(runs, [&] {
+      hits = 0;
+      for (const Move& move : moves) {
+        GridLine::Supercover(move.x0, move.y0, move.x1, move.y1,
+                             [&](int x, int y) {
+          if (isRock(x, y)) hits++;
+        });
+      }
+    });
+
+    std::printf("%-7d %9.2f (%6ld) %9.2f (%6ld) %9.2f (%6ld)\n", speed,
+                old_time, old_hits, bresenham_time, bresenham_hits, time,
+                hits);
+  }
+  return 0;
+}
@@ -0,0 +1,124 @@
+/**
+ *  \brief
+ *
+ *  Copyright (C) 2017  Chaos-Dev
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "Ballistics.h"
+
+/** Measures the per-turn range checks as the number of monsters grows.
+ *
+ *  The old way is Attacker::InRange as it was, called once per monster,
+ *  with a square root and two logarithms each.  The current way gathers
+ *  the monsters into flat arrays and calls Ballistics::CheckRanges once.
+ *  The line of fire is a lookup in the player's field of view either way,
+ *  so it is left out.  Both must pick the same monsters.
+ */
+
+struct Shooter {
+  int x, y;
+  int max_range;
+  int attack;
+};
+
+static const int PLAYER_X = 400, PLAYER_Y = 250, PLAYER_DODGE = 10;
+
+// Attacker::InRange and GetRangeModifier, before the range tables.
+static bool OldInRange(const Shooter& shooter) {
+  int dx = shooter.x - PLAYER_X;
+  int dy = shooter.y - PLAYER_Y;
+  float distance = std::sqrt(dx*dx + dy*dy);
+  if (shooter.max_range <= 1) return false;
+  if (distance > std::min(70, shooter.max_range)) return false;
+  if (distance <= 3) return true;
+  int modifier = int(15.0*std::log(distance)/
+                     std::log(float(shooter.max_range)) - 5.0);
+  return PLAYER_DODGE + modifier < shooter.attack;
+}
+
+template <typename F>
+static double TimeTurns(int turns, F turn) {
+  auto start = std::chrono::steady_clock::now();
+  for (int i=0; i<turns; i++) turn();
+  std::chrono::duration<double, std::micro> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count()/turns;
+}
+
+int main() {
+  const int ranges[] = {1, 5, 10, 20, 40, 70, 150};
+  std::mt19937 rng(1234);
+  // Crowd the monsters around the player, so most of them are in reach.
+  std::uniform_int_distribution<> random_dx(-100, 100);
+  std::uniform_int_distribution<> random_dy(-60, 60);
+  std::uniform_int_distribution<> random_range(0, 6);
+  std::uniform_int_distribution<> random_attack(5, 25);
+
+  std::printf("%9s %12s %12s %10s %10s\n", "monsters", "old (us)",
+              "current (us)", "old (ns)", "cur (ns)");
+  int mismatches = 0;
+  for (int count : {100, 300, 1000, 3000, 10000}) {
+    // Like the actors, each monster is its own allocation.
+    std::vector<Shooter*> shooters;
+    for (int i=0; i<count; i++) {
+      shooters.push_back(new Shooter{PLAYER_X + random_dx(rng),
+                                     PLAYER_Y + random_dy(rng),
+                                     ranges[random_range(rng)],
+                                     random_attack(rng)});
+    }
+    std::vector<uint8_t> old_result(count), can_hit(count);
+    std::vector<int16_t> positions(2*count);
+    std::vector<int> reach2(count), max_range(count), attack(count);
+    std::vector<int> distance2(count);
+    const int turns = 2000000/count;
+
+    double old_time = TimeTurns(turns, [&] {
+      for (int i=0; i<count; i++) old_result[i] = OldInRange(*shooters[i]);
+    });
+    double new_time = TimeTurns(turns, [&] {
+      for (int i=0; i<count; i++) {
+        const Shooter* shooter = shooters[i];
+        positions[2*i] = shooter->x;
+        positions[2*i+1] = shooter->y;
+        max_range[i] = shooter->max_range;
+        attack[i] = shooter->attack;
+        reach2[i] = Ballistics::Reach2(shooter->max_range);
+      }
+      Ballistics::CheckRanges(positions.data(), reach2.data(),
+                              max_range.data(), attack.data(), count,
+                              PLAYER_X, PLAYER_Y, true, PLAYER_DODGE,
+                              distance2.data(), can_hit.data());
+    });
+    for (int i=0; i<count; i++) {
+      if (old_result[i] != can_hit[i]) mismatches++;
+    }
+    std::printf("%9d %12.2f %12.2f %10.1f %10.1f\n", count, old_time,
+                new_time, 1000*old_time/count, 1000*new_time/count);
+    for (Shooter* shooter : shooters) delete shooter;
+  }
+  if (mismatches > 0) {
+    std::printf("%d monsters were judged differently\n", mismatches);
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,201 @@
+# Turns data/content.txt into the constant tables in ContentTables.h.
+#
+# Run with:
+#   cmake -DINPUT=<content.txt> -DOUTPUT=<ContentTables.h> -P GenerateContent.cmake
+
+# A script run with -P starts with no policies set.  Empty fields must stay
+# in the lists so the columns line up.
+cmake_policy(SET CMP0007 NEW)
+
+# Splits a line into its fields, with the spaces around them removed.
+function(split_fields line result)
+  string(REPLACE "|" ";" fields "${line}")
+  set(stripped "")
+  foreach(field IN LISTS fields)
+    string(STRIP "${field}" field)
+    list(APPEND stripped "${field}")
+  endforeach()
+  set(${result} "${stripped}" PARENT_SCOPE)
+endfunction()
+
+# Quotes a string for C++.  The game uses " " for words it has no use for.
+function(c_string text result)
+  if(text STREQUAL "")
+    set(text " ")
+  endif()
+  string(REPLACE "\\" "\\\\" text "${text}")
+  string(REPLACE "\"" "\\\"" text "${text}")
+  set(${result} "\"${text}\"" PARENT_SCOPE)
+endfunction()
+
+function(c_char text result)
+  if(text STREQUAL "'" OR text STREQUAL "\\")
+    set(text "\\${text}")
+  endif()
+  set(${result} "'${text}'" PARENT_SCOPE)
+endfunction()
+
+# Writes a list of words, e.g. for the Words constructor.
+function(c_words result)
+  set(quoted "")
+  foreach(word IN LISTS ARGN)
+    c_string("${word}" word)
+    list(APPEND quoted "${word}")
+  endforeach()
+  string(REPLACE ";" "," quoted "${quoted}")
+  set(${result} "Words(${quoted})" PARENT_SCOPE)
+endfunction()
+
+function(c_enum prefix name result)
+  if(name STREQUAL "NONE")
+    set(${result} "-1" PARENT_SCOPE)
+  else()
+    set(${result} "${prefix}${name}" PARENT_SCOPE)
+  endif()
+endfunction()
+
+set(levels "")
+set(archetypes "")
+set(variants "")
+set(items "")
+set(checks "")
+set(num_archetypes 0)
+set(last_type "")
+set(num_types 0)
+set(num_items 0)
+
+file(STRINGS "${INPUT}" lines)
+foreach(line IN LISTS lines)
+  string(STRIP "${line}" line)
+  if(line STREQUAL "" OR line MATCHES "^#")
+    set(table "")
+  else()
+    split_fields("${line}" fields)
+    list(GET fields 0 table)
+  endif()
+
+  if(table STREQUAL "")
+    # A comment or a blank line
+  elseif(table STREQUAL "level")
+    list(GET fields 1 title)
+    list(GET fields 2 water)
+    list(GET fields 3 beach)
+    list(GET fields 4 background)
+    list(GET fields 5 rock)
+    list(GET fields 6 common)
+    list(GET fields 7 chance)
+    list(GET fields 8 rare)
+    list(GET fields 9 weapon)
+    list(GET fields 10 armor)
+    c_string("${title}" title)
+    c_enum("Map::" "${weapon}" weapon)
+    c_enum("Map::" "${armor}" armor)
+    set(levels "${levels}  {${title}, Color(${water}), Color(${beach}),\n")
+    set(levels "${levels}   Color(${background}), Color(${rock}),\n")
+    set(levels "${levels}   Map::${common}, ${chance}, Map::${rare}, ${weapon}, ${armor}},\n")
+
+  elseif(table STREQUAL "monster")
+    list(GET fields 1 type)
+    list(GET fields 2 glyph)
+    list(GET fields 3 color)
+    list(GET fields 4 speed)
+    list(GET fields 5 flags)
+    list(GET fields 6 hp)
+    list(GET fields 7 armor)
+    list(GET fields 8 attack)
+    list(GET fields 9 dodge)
+    list(GET fields 10 damage)
+    list(GET fields 11 range)
+    list(GET fields 12 name)
+    list(GET fields 13 Name)
+    list(GET fields 14 corpse)
+    list(GET fields 15 possessive)
+    list(GET fields 16 weapon)
+    list(GET fields 17 armor_name)
+    c_char("${glyph}" glyph)
+    set(can_fly false)
+    set(fades false)
+    if(flags MATCHES "fly")
+      set(can_fly true)
+    endif()
+    if(flags MATCHES "fades")
+      set(fades true)
+    endif()
+    if(possessive MATCHES "^(.*)/(.*)$")
+      set(his "${CMAKE_MATCH_1}")
+      set(her "${CMAKE_MATCH_2}")
+    else()
+      set(his "${possessive}")
+      set(her "${possessive}")
+    endif()
+    c_words(his_words "${name}" "${Name}" "${corpse}" "${his}" "${weapon}" "${armor_name}")
+    c_words(her_words "${name}" "${Name}" "${corpse}" "${her}" "${weapon}" "${armor_name}")
+    set(archetypes "${archetypes}  {${glyph}, Color(${color}), ${speed}, ${can_fly}, ${fades},\n")
+    set(archetypes "${archetypes}   ${hp}, {${armor}, ${attack}, ${dodge}, ${damage}, ${range}},\n")
+    set(archetypes "${archetypes}   {${his_words},\n    ${her_words}}},\n")
+
+    # Count the variants of each type, which are listed together.
+    if(type STREQUAL last_type)
+      math(EXPR count "${count} + 1")
+    else()
+      if(NOT last_type STREQUAL "")
+        set(variants "${variants}  {${first}, ${count}},  // ${last_type}\n")
+      endif()
+      set(checks "${checks}static_assert(Map::${type} == ${num_types},\n")
+      set(checks "${checks}              \"Monsters must be listed in the order of Map::MonsterType\");\n")
+      math(EXPR num_types "${num_types} + 1")
+      set(first ${num_archetypes})
+      set(count 1)
+      set(last_type "${type}")
+    endif()
+    math(EXPR num_archetypes "${num_archetypes} + 1")
+
+  elseif(table STREQUAL "item")
+    list(GET fields 1 type)
+    list(GET fields 2 glyph)
+    list(GET fields 3 color)
+    list(GET fields 4 damage)
+    list(GET fields 5 range)
+    list(GET fields 6 armor)
+    list(GET fields 7 name)
+    list(GET fields 8 Name)
+    list(GET fields 9 weapon)
+    c_char("${glyph}" glyph)
+    c_words(words "${name}" "${Name}" "" "" "${weapon}" "")
+    set(items "${items}  {${glyph}, Color(${color}), ${damage}, ${range}, ${armor},\n")
+    set(items "${items}   ${words}},\n")
+    set(checks "${checks}static_assert(Map::${type} == ${num_items},\n")
+    set(checks "${checks}              \"Items must be listed in the order of Map::ItemType\");\n")
+    math(EXPR num_items "${num_items} + 1")
+
+  else()
+    message(FATAL_ERROR "${INPUT}: unknown table '${table}' in: ${line}")
+  endif()
+endforeach()
+if(NOT last_type STREQUAL "")
+  set(variants "${variants}  {${first}, ${count}},  // ${last_type}\n")
+endif()
+
+file(WRITE "${OUTPUT}"
+"// Generated from data/content.txt by cmake/GenerateContent.cmake.
+// Edit the data file instead of this one.
+
+#ifndef CONTENTTABLES_H_
+#define CONTENTTABLES_H_
+
+static constexpr LevelData level_table[] = {
+${levels}};
+
+static constexpr Archetype archetype_table[] = {
+${archetypes}};
+
+// The first archetype of each Map::MonsterType, and how many there are.
+static constexpr int monster_variants[][2] = {
+${variants}};
+
+static constexpr ItemData item_table[] = {
+${items}};
+
+${checks}
+#endif /* CONTENTTABLES_H_ */
+")
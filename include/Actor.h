@@ -21,6 +21,7 @@
 #define INCLUDE_ACTOR_H_
 
 class Actor;
+#include "Archetype.h"
 #include "Words.h"
 #include "Ai.h"
 #include "Color.h"
@@ -30,25 +31,45 @@ class Actor;
 
 class Actor {
  private:
-  
+  static int next_id;
  public:
+  // Actors are drawn in this order, bottom first.
+  enum RenderLayer {
+    PROPS,      // Rocks, and anything else that's part of the terrain
+    CORPSES,
+    ITEMS,
+    CREATURES,
+    RAFT,
+    PLAYER,
+    NUM_RENDER_LAYERS
+  };
+
+  int id;
   int x, y;
   int symbol;
   int speed;
   bool can_fly;
   bool blocks;
   Color color;
-  Words* words;
+  const Words* words;  // Shared with every actor of the same kind
+  int archetype;       // Index in the archetype table, or -1 if not a monster
+  Stats* stats;        // The player's and the raft's own stats, or nullptr
   Ai* ai;
   Destructible* destructible;
   Attacker* attacker;
   Item* item;
+  RenderLayer render_layer;
+  int entity;        // Position in the engine's ActorStore, or -1
   
   Actor(int x, int y, int symbol, Color color, int speed);
-  ~Actor();
   void Update();
   void ProcessInput(int key, bool shift);
   float GetDistance(int cx, int cy) const;
+  const char* GetName() const;
+  // Only for actors that can fight or be hurt.
+  const Stats& GetStats() const {
+    return stats ? *stats : Archetype::Get(archetype).stats;
+  };
 };
 
 #endif /* INCLUDE_ACTOR_H_ */
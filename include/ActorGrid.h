@@ -0,0 +1,60 @@
+/**
+ *  \brief
+ *
+ *  Copyright (C) 2017  Chaos-Dev
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INCLUDE_ACTORGRID_H_
+#define INCLUDE_ACTORGRID_H_
+
+#include <cstdint>
+#include <vector>
+
+class Actor;
+class ActorStore;
+
+/** Finds the actors standing on a tile without looking at every actor.
+ *
+ *  Each tile holds the start of a linked list of the entities on it,
+ *  threaded through an array with one entry per entity.  The lists are
+ *  rebuilt from the actor store's arrays in one pass the first time they
+ *  are queried after the world has changed, and keep the entities in the
+ *  order they are drawn.
+ *
+ *  Blocking is counted by the store itself, which is kept up to date as
+ *  actors move, so walkability can be checked in the middle of a turn.
+ */
+class ActorGrid {
+ protected:
+  int width, height;
+  long version;              // World version the lists were built for
+  const ActorStore* store;   // The store the lists were built from
+  std::vector<int> first;    // First entry on each tile, or -1
+  std::vector<int> next;     // Next entry on the same tile, or -1
+  std::vector<int> used;     // Tiles that have a list, to clear them quickly
+  std::vector<int> order;    // The entities, sorted by render layer
+
+ public:
+  ActorGrid(int width, int height);
+  void Update(const ActorStore& store, long version);
+  void GetActors(int x, int y, std::vector<Actor*>& found) const;
+  void GetActorsIn(int x0, int y0, int x1, int y1,
+                   std::vector<Actor*>& found) const;
+  void GetEntitiesIn(int x0, int y0, int x1, int y1,
+                     std::vector<int>& found) const;
+};
+
+#endif /* INCLUDE_ACTORGRID_H_ */
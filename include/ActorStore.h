@@ -0,0 +1,111 @@
+/**
+ *  \brief
+ *
+ *  Copyright (C) 2017  Chaos-Dev
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef INCLUDE_ACTORSTORE_H_
+#define INCLUDE_ACTORSTORE_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "Archetype.h"
+#include "BearLibTerminal.h"
+
+class Actor;
+
+/** A set of entities that can be walked as a dense list.
+ *
+ *  Adding, removing and testing for an entity take constant time.  Removing
+ *  moves the last entity into the gap, so the order isn't kept.
+ */
+class EntitySet {
+ protected:
+  std::vector<int> dense;   // The entities in the set
+  std::vector<int> sparse;  // Position of each entity in dense, or -1
+
+ public:
+  void Insert(int entity);
+  void Erase(int entity);
+  void Rename(int from, int to);
+  bool Contains(int entity) const;
+  int IndexOf(int entity) const;
+  void Clear();
+  int Size() const { return dense.size(); };
+  int operator[](int i) const { return dense[i]; };
+};
+
+/** The actors on a level, with their hot fields in parallel arrays.
+ *
+ *  An entity is an actor's position in the arrays.  Everything the turn
+ *  loop, the occupancy checks and the renderer read is kept here, so they
+ *  walk contiguous memory rather than following a pointer per actor.  The
+ *  Actor keeps the cold data (words, Ai, Destructible, Attacker, Item).
+ *  The optional components are sparse sets of the entities that have them.
+ *
+ *  Removing an actor moves the last one into its place, so entities are
+ *  only stable until the next removal.  Each Actor holds its entity.
+ *
+ *  The Actor's own position and flags are kept in step by the engine's
+ *  AddActor, MoveActor, SetBlocks and SetRenderLayer, which are the only
+ *  ways they change.  The store also counts the blocking actors on each
+ *  tile, so walkability is one lookup.
+ */
+class ActorStore {
+ public:
+  enum Flag : uint8_t {
+    BLOCKS = 1,
+    CAN_FLY = 2,
+    ACTIVE = 4,   // A monster that has noticed the player
+  };
+
+  // Indexed by entity
+  std::vector<Actor*> actors;
+  std::vector<int16_t> x, y;
+  std::vector<uint8_t> flags;
+  std::vector<uint8_t> layer;    // An Actor::RenderLayer
+  std::vector<uint8_t> speed;
+  std::vector<int16_t> hp;
+  std::vector<int16_t> attack, dodge, max_range;
+  std::vector<int> symbol;
+  std::vector<color_t> color;
+
+  EntitySet ai;    // Monsters, whose turns the engine runs
+  EntitySet item;  // Actors that can be picked up
+
+  ActorStore(int width, int height);
+  int Add(Actor* actor, const Stats& stats);
+  void Remove(int entity);
+  void Move(int entity, int x, int y);
+  void SetBlocks(int entity, bool blocks);
+  void SetLayer(int entity, int layer);
+  void SetHp(int entity, int hp);
+  void SetStats(int entity, const Stats& stats);
+  void Clear();
+  int Size() const { return actors.size(); };
+  bool CanWalk(int x, int y) const;
+  int CountBlockers(int x, int y) const;
+
+ protected:
+  int width, height;
+  std::vector<uint16_t> blockers;  // Blocking actors on each tile
+
+  void AddBlocker(int x, int y, int count);
+};
+
+#endif /* INCLUDE_ACTORSTORE_H_ */
@@ -28,28 +28,31 @@ class Actor;
  */
 class Ai {
 public :
-    ~Ai() {};
-	virtual void Update(Actor *owner)=0;
-	virtual void ProcessInput(Actor *owner, int key, bool shift)=0;
-	virtual bool isActive(Actor *owner) = 0;
-protected :
 	enum AiType {
 		MONSTER, PLAYER
 	};
+	// Lets the engine group actors by behaviour, and call each group's
+	// Update directly instead of through the vtable.
+	const AiType type;
+
+	Ai(AiType type) : type(type) {};
+	virtual ~Ai() {};
+	virtual void Update(Actor *owner)=0;
+	virtual void ProcessInput(Actor *owner, int key, bool shift)=0;
+	virtual bool isActive(Actor *owner) = 0;
 };
 
-class MonsterAi : public Ai {
+class MonsterAi final : public Ai {
 public :
 	MonsterAi();
 	void Update(Actor *owner);
 	void ProcessInput(Actor *owner, int key, bool shift);
 	bool isActive(Actor *owner);
 protected :
-  bool active; // Is the monster active?
   void moveOrAttack(Actor *owner, int targetx, int targety);
 };
 
-class PlayerAi : public Ai {
+class PlayerAi final : public Ai {
 public :
 	PlayerAi();
   void Update(Actor *owner);
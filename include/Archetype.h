@@ -0,0 +1,53 @@
+/**
+ *  \brief
+ *
+ *  Copyright (C) 2017  Chaos-Dev
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INCLUDE_ARCHETYPE_H_
+#define INCLUDE_ARCHETYPE_H_
+
+#include "Color.h"
+#include "Words.h"
+
+// The combat stats of an actor.  Monsters read them from their archetype;
+// the player and the raft have their own, which change as items are found.
+struct Stats {
+  int armor;
+  int attack, dodge, mean_damage, max_range;
+};
+
+/** The fixed data for one kind of monster, from data/content.txt.
+ *
+ *  Every monster keeps the index of its archetype, and reads its words and
+ *  stats from the table.  It only keeps the state that changes during play
+ *  (position, hit points, aim) for itself.
+ */
+struct Archetype {
+  int symbol;
+  Color color;
+  int speed;
+  bool can_fly;
+  bool fades;       // Vanishes when killed, rather than leaving a corpse
+  int hp;
+  Stats stats;
+  Words words[2];   // Referring to the monster as "his", then as "her"
+
+  static int Find(int monster_type, int roll);
+  static const Archetype& Get(int index);
+};
+
+#endif /* INCLUDE_ARCHETYPE_H_ */
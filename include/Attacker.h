@@ -22,23 +22,21 @@
 
 class Actor;
 
+/** Aims and makes attacks.
+ *
+ *  The attack, dodge, damage and range come from the owner's stats, so
+ *  only the aim is kept here.
+ */
 class Attacker {
 protected:
     bool firing;
     Actor* current_target;
-    int attack;
-    int dodge;
-	bool DoesItHit(int dice, int mod, Actor *target);
-	int GetDamage(int mean_damage, int mod, Actor* target);
-	void Message(bool hits, bool penetrates, bool dodged, int damage, Actor *owner, Actor *target);
+	bool DoesItHit(int dice, int mod, Actor *target, int *dodge_roll);
+	int GetDamage(int mean_damage, int mod, Actor* target, int *damage_roll);
 	int GetRangeModifier(Actor* owner, Actor* target);
 
 public :
-    int max_range;
-    int mean_damage;
-    
 	Attacker();
-	Attacker(int attack, int dodge, int mean_damage, int max_range);
 	void Attack(Actor *owner, Actor *target, int mod);
 	void SetAim(Actor* target);
 	bool UpdateFiring(Actor* owner);
@@ -0,0 +1,45 @@
+/**
+ *  \brief
+ *
+ *  Copyright (C) 2017  Chaos-Dev
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INCLUDE_BALLISTICS_H_
+#define INCLUDE_BALLISTICS_H_
+
+#include <cstdint>
+
+/** The arithmetic of ranged attacks, for one shooter or many at once.
+ *
+ *  Distances are compared squared, so no square roots are taken, and the
+ *  logarithms in the range modifier come from tables.  CheckRanges works
+ *  on flat arrays of shooters.  With SSE2 (always there on x86-64), it
+ *  finds the distances of four shooters at once.  Otherwise, a scalar
+ *  version gives exactly the same results.
+ */
+class Ballistics {
+ public:
+  static const int max_reach = 70;  // No shot is taken from further away
+
+  static int Reach2(int max_range);
+  static int RangeModifier(int distance2, int max_range);
+  static void CheckRanges(const int16_t* positions, const int* reach2,
+                          const int* max_range, const int* attack, int n,
+                          int target_x, int target_y, bool target_dodges,
+                          int target_dodge, int* distance2, uint8_t* can_hit);
+};
+
+#endif /* INCLUDE_BALLISTICS_H_ */
@@ -24,8 +24,8 @@
 struct Color {
     int r,g,b;
     
-    Color() : r(0), g(0), b(0) {};
-    Color(int r, int g, int b) : r(r), g(g), b(b) {};
+    constexpr Color() : r(0), g(0), b(0) {};
+    constexpr Color(int r, int g, int b) : r(r), g(g), b(b) {};
     void Update(int r_new, int g_new, int b_new) {
       r = r_new; g = g_new; b = b_new;
     };
@@ -50,6 +50,10 @@ struct Color {
         return color;
     };
     
+    bool operator==(const Color& rhs) const {
+        return r == rhs.r && g == rhs.g && b == rhs.b;
+    };
+    
     Color operator*(const float& scalar) {
         Color color;
         color.r = this->r * scalar;
@@ -0,0 +1,57 @@
+/**
+ *  \brief
+ *
+ *  Copyright (C) 2017  Chaos-Dev
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef INCLUDE_COLORRUNS_H_
+#define INCLUDE_COLORRUNS_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "BearLibTerminal.h"
+
+// A stretch of tiles in one row that share the same colour, so they can be
+// drawn as a single span.  Water changes colour from tile to tile, so it is
+// left as runs of one tile that are drawn a cell at a time.
+struct ColorRun {
+    int start, end;  // First tile, and one past the last tile
+    bool water;
+    ColorRun(int start, int end, bool water)
+        : start(start), end(end), water(water) {};
+};
+
+/** The rows of a level, split into runs of tiles with the same colour.
+ *
+ *  The colours never change during a level, so the runs are found once,
+ *  and let the renderer fill most of the screen with a few spans.  The
+ *  runs of each row are in order and cover the whole row.
+ */
+class ColorRuns {
+ public:
+  void Build(const std::vector<color_t>& colors,
+             const std::vector<bool>& water, int width, int height);
+  const ColorRun* Find(int y, int x) const;
+  const ColorRun* RowEnd(int y) const;
+  int Count() const { return runs.size(); };
+ private:
+  std::vector<ColorRun> runs;  // Runs of every row, bottom row first
+  std::vector<int> row_runs;   // First run of each row, plus the total
+};
+
+#endif /* INCLUDE_COLORRUNS_H_ */
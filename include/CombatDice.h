@@ -0,0 +1,51 @@
+/**
+ *  \brief
+ *
+ *  Copyright (C) 2017  Chaos-Dev
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INCLUDE_COMBATDICE_H_
+#define INCLUDE_COMBATDICE_H_
+
+#include <cstdint>
+
+/** Rolls the dice for combat.
+ *
+ *  The numbers come from xoshiro256**, which is much faster than the
+ *  Mersenne Twister and passes the BigCrush and PractRand test suites
+ *  (Blackman and Vigna, "Scrambled Linear Pseudorandom Number Generators",
+ *  2018).  Normal variates are made in batches with the Box-Muller
+ *  transform, which gives two per pair of uniform numbers, and handed out
+ *  one at a time until the batch is used up.
+ */
+class CombatDice {
+ protected:
+  static const int BATCH_SIZE = 256;
+  uint64_t state[4];
+  float normals[BATCH_SIZE];
+  int next_normal;
+
+  uint64_t Next();
+  void FillNormals();
+
+ public:
+  CombatDice();
+  void Seed(uint64_t seed);
+  float Uniform();
+  float Normal(float mean, float stddev);
+};
+
+#endif /* INCLUDE_COMBATDICE_H_ */
@@ -0,0 +1,76 @@
+/**
+ *  \brief
+ *
+ *  Copyright (C) 2017  Chaos-Dev
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INCLUDE_COMBATLOG_H_
+#define INCLUDE_COMBATLOG_H_
+
+#include <vector>
+
+class Actor;
+class Log;
+
+// The result of a single attack.
+struct CombatEvent {
+  enum Outcome {
+    HIT,      // Hit and got through the target's armor
+    BOUNCED,  // Hit, but didn't get through the armor
+    MISSED,
+    DODGED,
+    IN_VAIN   // The target can't be damaged at all
+  };
+  int attacker_id, target_id;
+  const Actor* attacker;  // Only valid until EndTurn
+  const Actor* target;
+  int attack, attack_roll;
+  int dodge, dodge_roll;  // -1 if the target couldn't dodge
+  int mean_damage, damage_roll;  // -1 if the attack didn't hit
+  int damage;
+  Outcome outcome;
+};
+
+/** Keeps the attacks made during the current turn.
+ *
+ *  Attacks are recorded as events, and are only turned into sentences when
+ *  the log is about to be drawn, or when something else is printed to the
+ *  log, so the messages stay in order.  With text turned off (e.g. for
+ *  batch runs), the events are still kept for the rest of the turn.  They
+ *  are dropped by EndTurn, which the engine calls at the end of every turn
+ *  and before a level's actors are released.
+ */
+class CombatLog {
+ protected:
+  Log* log;
+  std::vector<CombatEvent> events;
+  unsigned int num_written;  // Events already written to the log
+  int turn;
+  bool flushing;
+
+  void Write(const CombatEvent& event);
+
+ public:
+  bool text_enabled;
+
+  CombatLog(Log* log);
+  void Add(const CombatEvent& event, int turn);
+  void Flush();
+  void EndTurn();
+  const std::vector<CombatEvent>& GetEvents() const { return events; };
+};
+
+#endif /* INCLUDE_COMBATLOG_H_ */
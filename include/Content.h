@@ -0,0 +1,49 @@
+/**
+ *  \brief
+ *
+ *  Copyright (C) 2017  Chaos-Dev
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INCLUDE_CONTENT_H_
+#define INCLUDE_CONTENT_H_
+
+#include "Archetype.h"
+#include "Color.h"
+#include "Words.h"
+
+// The look and the inhabitants of one level, from data/content.txt.
+struct LevelData {
+  const char* title;
+  Color water, beach, background, rock;
+  int common_monster;  // A Map::MonsterType
+  int common_chance;   // Percent of the monsters that are the common one
+  int rare_monster;
+  int weapon, armor;   // A Map::ItemType, or -1 if there isn't one
+
+  static const LevelData& Get(int level);
+};
+
+// The fixed data for one kind of item, from data/content.txt.
+struct ItemData {
+  int symbol;
+  Color color;
+  int damage, max_range, armor;
+  Words words;
+
+  static const ItemData& Get(int item_type);
+};
+
+#endif /* INCLUDE_CONTENT_H_ */
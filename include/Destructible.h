@@ -25,9 +25,9 @@ class Destructible {
 public :
 	int maxHp; // maximum health points
 	int hp; // current health points
-	int armor; // strength of their armor
 
-	Destructible(int maxHp, int armor);
+	Destructible(int maxHp);
+	virtual ~Destructible() {};
 	inline bool isDead() { return hp <= 0; }
 	int takeDamage(Actor *owner, int damage);
 	int heal(float amount);
@@ -38,27 +38,27 @@ protected :
 	};
 };
 
-class MonsterDestructible : public Destructible {
+class MonsterDestructible final : public Destructible {
 public :
-	MonsterDestructible(int maxHp, int armor);
+	MonsterDestructible(int maxHp);
 	void die(Actor *owner);
 };
 
-class PlayerDestructible : public Destructible {
+class PlayerDestructible final : public Destructible {
 public :
-	PlayerDestructible(int maxHp, int armor);
+	PlayerDestructible(int maxHp);
 	void die(Actor *owner);
 };
 
-class RaftDestructible : public Destructible {
+class RaftDestructible final : public Destructible {
 public :
-	RaftDestructible(int maxHp, int armor);
+	RaftDestructible(int maxHp);
 	void die(Actor *owner);
 };
 
-class GhostDestructible : public Destructible {
+class GhostDestructible final : public Destructible {
 public :
-	GhostDestructible(int maxHp, int armor);
+	GhostDestructible(int maxHp);
 	void die(Actor *owner);
 };
 #endif // INCLUDE_DESTRUCTIBLE_H_
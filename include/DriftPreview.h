@@ -0,0 +1,59 @@
+/**
+ *  \brief
+ *
+ *  Copyright (C) 2017  Chaos-Dev
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INCLUDE_DRIFTPREVIEW_H_
+#define INCLUDE_DRIFTPREVIEW_H_
+
+#include <vector>
+
+#include "Map.h"
+
+/** Shows where the current will carry the raft over the next few turns.
+ *
+ *  A path is projected for each of the nine moves the player can make this
+ *  turn, followed by holding position.  The paths come from the map's drift
+ *  tables and are only recalculated when the player moves, so drawing them
+ *  costs about the same as drawing a few actors.
+ */
+class DriftPreview {
+ protected:
+  const int turns = 5;
+  struct Step {
+    Position position;
+    int turn;
+    bool hits_rock;
+    Step(Position position, int turn, bool hits_rock)
+      : position(position), turn(turn), hits_rock(hits_rock) {};
+  };
+  std::vector<Step> steps;
+  Position origin;
+  bool dirty;
+
+  void AddPath(const Map& map, int dx, int dy);
+
+ public:
+  bool enabled;
+
+  DriftPreview();
+  void Invalidate();
+  void Update(const Map& map, int x, int y);
+  void Render(Panel panel, Position* camera) const;
+};
+
+#endif /* INCLUDE_DRIFTPREVIEW_H_ */
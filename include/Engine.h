@@ -20,13 +20,23 @@
 #ifndef INCLUDE_ENGINE_H_
 #define INCLUDE_ENGINE_H_
 
-#include <deque>
 #include <random>
+#include <vector>
 
 #include "Map.h"
+#include "Fov.h"
+#include "DriftPreview.h"
+#include "RoutePlanner.h"
+#include "ThreatPass.h"
+#include "ActorGrid.h"
+#include "ActorStore.h"
+#include "Overview.h"
 #include "Actor.h"
 #include "Ai.h"
 #include "Gui.h"
+#include "CombatLog.h"
+#include "CombatDice.h"
+#include "Pool.h"
 
 class Engine {
  protected:
@@ -36,28 +46,51 @@ class Engine {
   int width, height;
   Panel map_panel;
   const int symbol = 0x2588;
+  const int FOV_RADIUS = 70;
 
   void ProcessInput();
   void Update();
   void UpdateMouse();
   void Render();
-  void RenderActor(Actor* actor);
+  void RenderMap();
+  void RenderActors();
+  void RenderRoute();
   bool PickATile(int key, int *x, int *y, int max_range);
+  int planned_turn;       // Turn and position the route was planned for
+  Position planned_from;
+  std::vector<int> visible_entities;
+
+  void ReleaseLevel();
 
  public:
   const int NEXT_LEVEL_POINT = 50;
+  const int TILE_CODE = 0xE000;  // Code of the first tile in the tile set
   int level;
+  int turn;
   Actor* player;
   Actor* raft;
   Map* map;
   Position* camera;
   Position* mouse;
   Gui* gui;
-  std::deque<Actor*> actors;
+  CombatLog* combat_log;
+  CombatDice* dice;  // Rolls for attacks, dodges and damage
+  Fov* fov;
+  DriftPreview* drift_preview;
+  RoutePlanner* route_planner;
+  ThreatPass* threat_pass;
+  ActorStore* actor_store;  // Everything on the level
+  ActorGrid* actor_grid;
+  Overview* overview;
+  Pool* level_pool;  // Owns everything on the current level
+  Pool* game_pool;   // Owns the player and the raft, for the whole game
+  bool show_route;
+  long world_version;  // Bumped whenever the actors may have changed
   std::mt19937 rng;  // Random number generator
   enum TileLayer {
     MAP=0,
     ACTORS,
+    OVERLAY,
     SIDEBAR_BG,
     SIDEBAR_TEXT,
     SIDEBAR_CONTROLS,
@@ -87,6 +120,16 @@ class Engine {
   void NextLevel();
   void Load(bool pause=false);
   bool CursorOnMap();
+  bool OnRaft() const;
+  bool PlanRoute();
+  void AddActor(Actor* actor, Actor::RenderLayer layer);
+  void RemoveActor(Actor* actor);
+  void SetRenderLayer(Actor* actor, Actor::RenderLayer layer);
+  void MoveActor(Actor* actor, int x, int y);
+  void SetBlocks(Actor* actor, bool blocks);
+  void ClearActors();
+  void GetActorsAt(int x, int y, std::vector<Actor*>& found);
+  void GetActorsIn(int x0, int y0, int x1, int y1, std::vector<Actor*>& found);
 };
 
 extern Engine engine;
@@ -0,0 +1,57 @@
+/**
+ *  \brief
+ *
+ *  Copyright (C) 2017  Chaos-Dev
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INCLUDE_FOV_H_
+#define INCLUDE_FOV_H_
+
+#include <cstdint>
+#include <vector>
+
+class Map;
+
+/** The player's field of view, computed with recursive shadowcasting.
+ *
+ *  Visibility is stored as a bit-packed square window centered on the
+ *  player.  Since every monster shoots at the player, the same mask answers
+ *  the line-of-fire question for all of them, so the cost of a turn does not
+ *  grow with the number of ranged monsters.
+ */
+class Fov {
+ protected:
+  const int radius;
+  const int size;             // Width and height of the window (2*radius+1)
+  const int words_per_row;    // 64-bit words needed to hold one window row
+  int origin_x, origin_y;
+  bool dirty;
+  std::vector<uint64_t> visible;
+
+  void CastLight(const Map& map, int row, float start, float end,
+                 int xx, int xy, int yx, int yy);
+  void SetVisible(int x, int y);
+  bool TraceLine(const Map& map, int x0, int y0, int x1, int y1) const;
+
+ public:
+  Fov(int radius);
+  void Reset();
+  void Update(const Map& map, int x, int y);
+  bool isVisible(int x, int y) const;
+  bool LineOfFire(const Map& map, int x0, int y0, int x1, int y1) const;
+};
+
+#endif /* INCLUDE_FOV_H_ */
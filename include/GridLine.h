@@ -0,0 +1,88 @@
+/**
+ *  \brief
+ *
+ *  Copyright (C) 2017  Chaos-Dev
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef INCLUDE_GRIDLINE_H_
+#define INCLUDE_GRIDLINE_H_
+
+#include <cstdlib>
+
+/** Walks the tiles under a straight line between the centres of two tiles.
+ *
+ *  This is a supercover: every tile the line touches is visited, not just
+ *  one per step as with Bresenham.  Where the line passes exactly through
+ *  the corner of four tiles, both of the tiles beside the corner are
+ *  visited before the one diagonally across, so a rock can't be slipped
+ *  past on a diagonal.  The walk takes |dx| + |dy| steps at most, so it
+ *  always ends, however fast the river is flowing.
+ */
+class GridLine {
+ public:
+  /** Calls visit(x, y) for each tile in order, ending with the final tile.
+   *
+   * @param x0 - The x coordinate of the starting tile, which is not visited
+   * @param y0 - The y coordinate of the starting tile
+   * @param x1 - The x coordinate of the final tile
+   * @param y1 - The y coordinate of the final tile
+   * @param visit - Called with the coordinates of each tile
+   */
+  template <typename Visit>
+  static void Supercover(int x0, int y0, int x1, int y1, Visit visit) {
+    int x_step = (x1 < x0 ? -1 : 1), y_step = (y1 < y0 ? -1 : 1);
+    int dx = std::abs(x1 - x0), dy = std::abs(y1 - y0);
+    if (dx >= dy) {
+      Walk(x0, y0, x_step, y_step, dx, dy, visit, false);
+    } else {
+      Walk(y0, x0, y_step, x_step, dy, dx, visit, true);
+    }
+  }
+
+ private:
+  // Steps along the major axis a, moving along the minor axis b whenever
+  // the error passes a whole tile.  The error is kept doubled so the
+  // midpoints between tiles are integers.
+  template <typename Visit>
+  static void Walk(int a, int b, int a_step, int b_step, int da, int db,
+                   Visit& visit, bool swapped) {
+    int error = da, previous = da;
+    for (int i=0; i<da; i++) {
+      a += a_step;
+      error += 2*db;
+      if (error > 2*da) {
+        b += b_step;
+        error -= 2*da;
+        if (error + previous <= 2*da) Visit2(visit, swapped, a, b - b_step);
+        if (error + previous >= 2*da) Visit2(visit, swapped, a - a_step, b);
+      }
+      Visit2(visit, swapped, a, b);
+      previous = error;
+    }
+  }
+
+  template <typename Visit>
+  static void Visit2(Visit& visit, bool swapped, int a, int b) {
+    if (swapped) {
+      visit(b, a);
+    } else {
+      visit(a, b);
+    }
+  }
+};
+
+#endif /* INCLUDE_GRIDLINE_H_ */
@@ -19,22 +19,46 @@
 #ifndef INCLUDE_GUI_H_
 #define INCLUDE_GUI_H_
 
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <cmath>
+#include <fstream>
 #include <sstream>
 
 #include "Color.h"
 #include "Menu.h"
 
-// A string plus its precalculated height.
-struct Message {
-	Message() : height(0) { };
+class Actor;
 
-	Message(const std::string& text) : text(text), height(0) { };
+// A span of the log's text arena plus its precalculated height and position
+// in the log.
+struct Message {
+	Message() : offset(0), length(0), hash(0), base_length(0), height(0),
+	            top(0) { };
 
-	std::string text;
+	size_t offset;      // Start of the text in the arena
+	size_t length;      // Length of the text, not counting the terminating null
+	uint32_t hash;      // Hash of the text before any repeat count was added,
+	size_t base_length; //   and the length of that text
 	int height;
+	long top; // First text row of the message, counted from the first message
+	          // ever printed, so it never changes once set.
+};
+
+// A part of the sidebar that is only drawn again when what it shows changes.
+// The terminal keeps the cells from the last draw, so an unchanged widget
+// costs one string comparison instead of laying out its text again.
+struct Widget {
+  std::string key;    // Everything the widget showed when it was last drawn
+  bool dirty = true;  // Draw it next time, even if the key is the same
+
+  bool Changed(const std::string& new_key) {
+    if (!dirty && new_key == key) return false;
+    key = new_key;
+    dirty = false;
+    return true;
+  };
 };
 
 class Log {
@@ -42,27 +66,53 @@ class Log {
   const int sidebar_width;
   const int padding_left = 1;
   const int padding_right = 1;
-  const int padding_top = 18;
+  int padding_top = 18;
   const int padding_bottom = 1;
   const int mouse_scroll_step = 2; // 2 text rows per mouse wheel step.
   const int line_padding = 0;
+  const int max_messages = 1000;   // Older messages are dropped or spilled.
+  const size_t initial_arena_size = 1 << 17;
+  const size_t max_suffix_length = 24; // Room for a " [[x123]]" repeat count
   int sidebar_start;
   int scrollbar_column;
   int scrollbar_offset;
 
+  // The messages are kept in a ring buffer, oldest first.
   std::vector<Message> messages;
+  int first_message = 0;
+  int num_messages = 0;
+  long next_top = 0;               // Where the next message will start
+  std::vector<char> arena;         // Text of every message, oldest first
+  size_t arena_end = 0;            // Where the next message's text will go
+  int measured_width = -1;         // Width the heights were measured for
+  std::string history_file;
+  std::ofstream history;
+
   int frame_offset = 0;
-  int frame_width;
+  int frame_width = 0;
   int frame_height = 0;
   int total_messages_height = 1;
   int scrollbar_height = 0;
   bool dragging_scrollbar = false;
   int dragging_scrollbar_offset = 0;
   void Reset();
-  int UpdateHeights();
+  Message& GetMessage(int index);
+  const char* GetText(const Message& message) const;
+  void AddMessage(size_t length, uint32_t hash, size_t base_length);
+  void AddPrinted(size_t length);
+  void ReserveText(size_t length);
+  static uint32_t Hash(const char* text, size_t length);
+  void RemoveLastMessage();
+  void SpillMessage(const Message& message);
+  void Measure(Message& message);
+  void UpdateHeights();
+  int GetHeight();
+  int FindMessage(int line);
   void UpdateGeometry();
   void ScrollToPixel(int py);
   int duplicate_count;
+  long version = 0;                // Bumped whenever the messages change
+  Widget view;
 
  public:
   Log(int sidebar_width);
@@ -72,16 +122,26 @@ class Log {
   void Update();
   void Render();
   void Clear();
+  void Invalidate();
+  void SetTop(int top);
+  void SetHistoryFile(const std::string& filename);
 };
 
 class Gui {
  private:
   const int sidebar_width;
+  const int minimap_top = 18;
+  const int minimap_min_height = 40; // Smaller windows leave it out
+  Widget title, help, mouse_look, health_bar, raft_bar, minimap;
+  std::vector<Actor*> found;  // Actors under the mouse cursor
+  bool needs_clear;
+  void ClearWidget(int x, int y, int width, int height);
   void RenderBar(int x, int y, int width, int offset, const char *name,
 		         float value, float maxValue, const Color barColor,
 		         const Color backColor);
   void RenderMouseLook(int x, int y);
   void RenderHelp(int x, int y);
+  bool ShowMinimap() const;
   const char* GetTitle();
  public:
   Log* log;
@@ -91,6 +151,8 @@ class Gui {
   void Update();
   void Render();
   void Clear();
+  void Invalidate();
+  bool NeedsClear() const { return needs_clear; };
   void MessageBox(const char* message);
   void DrawFrame(int x, int y, int width, int height);
 };
@@ -20,8 +20,12 @@
 #ifndef INCLUDE_MAP_H_
 #define INCLUDE_MAP_H_
 
+#include <cstdint>
+#include <vector>
+
 #include "River.h"
 #include "Color.h"
+#include "ColorRuns.h"
 #include "Actor.h"
 
 #include "BearLibTerminal.h"
@@ -49,15 +53,43 @@ struct Panel {
 
 struct Tile {
     bool canWalk;
+    bool rock;
     float vel, u, v;
-    Color color;
-    Tile() : canWalk(true), vel(0.0) {};
+    color_t color;
+    int decal;  // Index of the corpse left on the tile, or -1
+    Tile() : canWalk(true), rock(false), vel(0.0), decal(-1) {};
+};
+
+// What is left on a tile after a monster dies there.  Corpses are drawn
+// from here instead of being kept around as actors.
+struct Decal {
+    int symbol;
+    color_t color;
+    const char* name;
+    Decal(int symbol, color_t color, const char* name)
+        : symbol(symbol), color(color), name(name) {};
+};
+
+// How far the current carries something on a tile in one turn.  The
+// "move" offsets apply along an axis the player is paddling in, and the
+// "hold" offsets apply along an axis where they are holding position.
+struct Drift {
+    int8_t move_u, move_v;
+    int8_t hold_u, hold_v;
+    Drift() : move_u(0), move_v(0), hold_u(0), hold_v(0) {};
 };
 
 class Map {
  protected:
+  const uint16_t aiming_weight = 26;  // 10% white in range while aiming
   Color beach_color, water_color, bg_color, rock_color;
   std::vector<Tile> tiles;
+  std::vector<Drift> drift;
+  std::vector<int> drift_next; // Tile reached after holding for one turn
+  ColorRuns color_runs;
+  std::vector<color_t> vertex_colors; // Water colour at every half-tile corner
+  mutable std::vector<std::vector<int>> aiming_discs; // By weapon range
+  std::vector<Decal> decals;
   River* river;
   void AddMonster(int x, int y);
   void AddWeapon(int x, int y);
@@ -69,6 +101,10 @@ class Map {
   void SetWall(int x, int y);
   bool inBounds(int x, int y) const;
   void SetColors();
+  void CreateDriftTables();
+  void CreateColorRuns();
+  void CreateVertexColors();
+  const std::vector<int>& GetAimingDisc(int range) const;
  public:
    enum MonsterType {
       GHOST,
@@ -107,11 +143,19 @@ class Map {
   bool isWater(int x, int y) const;
   bool isBeach(int x, int y) const;
   bool isRock(int x, int y) const;
+  bool isOpaque(int x, int y) const;
+  int CountRocks(int x0, int y0, int x1, int y1) const;
   Position GetPlayerStart() const;
+  color_t GetColor(int x, int y) const;
   float GetUVelocity(int x, int y) const;
   float GetVVelocity(int x, int y) const;
+  Position GetDrift(int x, int y, int targetx, int targety) const;
+  Position GetDriftDestination(int x, int y, int turns) const;
   bool CanWalk(int x, int y) const;
+  void AddDecal(int x, int y, int symbol, Color color, const char* name);
+  const Decal* GetDecal(int x, int y) const;
   void Render(Panel panel, Position* camera) const;
+  void RenderDecals(Panel panel, Position* camera) const;
 };
 
 
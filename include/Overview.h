@@ -0,0 +1,76 @@
+/**
+ *  \brief
+ *
+ *  Copyright (C) 2017  Chaos-Dev
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INCLUDE_OVERVIEW_H_
+#define INCLUDE_OVERVIEW_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "Map.h"
+
+class Actor;
+
+/** A zoomed-out view of the whole level, and the minimap in the sidebar.
+ *
+ *  Both are drawn from a mip pyramid of the tile colours, where each level
+ *  is half the size of the one below.  The pyramid is built once per level,
+ *  so drawing a zoomed-out frame costs no more than drawing the map, no
+ *  matter where it is panned to.  The most important actor in each texel is
+ *  kept in a coarse grid, which is only rebuilt when the world changes.
+ */
+class Overview {
+ protected:
+  static const int num_levels = 6;
+  struct Level {
+    int width = 0, height = 0;
+    std::vector<uint8_t> r, g, b;  // One plane per channel
+  };
+  Level levels[num_levels];
+  std::vector<uint16_t> row_sum;   // Scratch space for the box filter
+  std::vector<const Actor*> marks; // Actor shown in each texel of the zoom
+  std::vector<int> marked;         // Texels that have an actor
+  long marks_version;
+  int marks_zoom;
+
+  void Downsample(const Level& src, Level& dst);
+  void DownsamplePlane(const std::vector<uint8_t>& src, int src_width,
+                       int src_height, std::vector<uint8_t>& dst,
+                       int dst_width, int dst_height);
+  color_t GetColor(const Level& level, int x, int y) const;
+  void UpdateMarks();
+
+ public:
+  static const int max_zoom = 3;
+  static const int minimap_level = 5;
+  int zoom;       // 0 to draw the map itself, or 1 to 3 for 2x, 4x and 8x
+  Position pan;   // Offset of the view from the camera, in tiles
+
+  Overview();
+  void Build(const Map& map);
+  void ZoomOut();
+  bool Pan(int key, const Panel& panel);
+  Position GetCenter(const Position& camera) const;
+  void Render(Panel panel, const Position& camera);
+  int GetMinimapWidth() const;
+  int GetMinimapHeight() const;
+  void RenderMinimap(int x, int y) const;
+};
+
+#endif /* INCLUDE_OVERVIEW_H_ */
@@ -0,0 +1,49 @@
+/**
+ *  \brief
+ *
+ *  Copyright (C) 2017  Chaos-Dev
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INCLUDE_PACKEDCOLOR_H_
+#define INCLUDE_PACKEDCOLOR_H_
+
+#include <cstdint>
+
+#include "BearLibTerminal.h"
+#include "Color.h"
+
+/** Blending for colours packed into 32 bits, in the terminal's ARGB order.
+ *
+ *  The weights are fixed point, where 256 means all of the second colour,
+ *  so the kernels only need 16-bit integer math.  With SSE2 (always there
+ *  on x86-64), four colours are blended at once.  Otherwise, a scalar
+ *  version gives exactly the same results.  Alpha is always left opaque.
+ */
+class PackedColor {
+ public:
+  static const int one = 256;  // Weight of a whole colour
+
+  static color_t Pack(const Color& color);
+  static uint16_t Weight(float fraction);
+
+  static void Lerp(const color_t* from, color_t to, const uint16_t* weights,
+                   color_t* out, int n);
+  static void Mix(const color_t* from, color_t to, uint16_t weight,
+                  color_t* out, int n);
+  static void Scale(const color_t* in, uint16_t scale, color_t* out, int n);
+};
+
+#endif /* INCLUDE_PACKEDCOLOR_H_ */
@@ -0,0 +1,80 @@
+/**
+ *  \brief
+ *
+ *  Copyright (C) 2017  Chaos-Dev
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INCLUDE_POOL_H_
+#define INCLUDE_POOL_H_
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/** Owns objects that all live and die together, like the actors on a level.
+ *
+ *  Objects are placed one after another in large blocks, so creating the
+ *  thousands of rocks, monsters and items on a level only takes a handful
+ *  of allocations.  They can't be freed one at a time.  Instead, Release
+ *  destroys them all at once, and keeps the blocks for the next level.
+ */
+class Pool {
+ protected:
+  struct Block {
+    std::unique_ptr<char[]> data;
+    size_t size;
+  };
+  // How to destroy an object that has a destructor
+  struct Cleanup {
+    void* object;
+    void (*destroy)(void*);
+  };
+  const size_t block_size;
+  std::vector<Block> blocks;
+  std::vector<Cleanup> cleanups;
+  size_t current;  // Block being filled
+  size_t used;     // Bytes used in the current block
+
+  void* Allocate(size_t size, size_t align);
+  template <typename T>
+  static void Destroy(void* object) { static_cast<T*>(object)->~T(); };
+
+ public:
+  Pool(size_t block_size = 64*1024);
+  ~Pool();
+  Pool(const Pool&) = delete;
+  Pool& operator=(const Pool&) = delete;
+
+  /** Creates an object that lasts until the pool is released.
+   *
+   * @param args - Passed on to the object's constructor
+   */
+  template <typename T, typename... Args>
+  T* New(Args&&... args) {
+    T* object = new (Allocate(sizeof(T), alignof(T)))
+        T(std::forward<Args>(args)...);
+    if (!std::is_trivially_destructible<T>::value)
+      cleanups.push_back({object, &Destroy<T>});
+    return object;
+  };
+  void Release();
+  size_t NumBlocks() const { return blocks.size(); };
+};
+
+#endif /* INCLUDE_POOL_H_ */
@@ -51,6 +51,7 @@ class River {
   std::vector<float> angle;
   std::vector<Rock> rocks;
   float GetVelocity(int x, int y);
+  float GetRelativeVelocity(float x, float y);
   bool isBeach(int x, int y);
   int GetPlayerStart(int x);
   std::vector<float> mean_velocity;
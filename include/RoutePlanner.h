@@ -0,0 +1,89 @@
+/**
+ *  \brief
+ *
+ *  Copyright (C) 2017  Chaos-Dev
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INCLUDE_ROUTEPLANNER_H_
+#define INCLUDE_ROUTEPLANNER_H_
+
+#include <vector>
+
+#include "Map.h"
+
+// A monster that can shoot at the raft from anywhere within its range.
+struct Threat {
+  int x, y;
+  int range;
+  Threat(int x, int y, int range) : x(x), y(y), range(range) {};
+};
+
+/** Finds the fastest safe way down the river on the raft.
+ *
+ *  Each turn the player picks one of nine moves and the current does the
+ *  rest, so a route is a sequence of moves.  A move costs one turn, plus a
+ *  penalty for each rock hit and for each monster in range.
+ *
+ *  The river never changes during a level, so the cost to reach the end of
+ *  the level from every water tile, ignoring monsters, is found once with a
+ *  backwards search.  Monsters move every turn, so they are only accounted
+ *  for over the next few turns, in a forward search that uses the stored
+ *  costs as an exact heuristic.  When the raft is on the previous route or
+ *  one move away from it, and nothing threatens it, it is reused.
+ */
+class RoutePlanner {
+ protected:
+  const int num_moves = 9;
+  const int threat_turns = 8;      // How far ahead monsters are considered
+  const float rock_cost = 6.0;     // Turns the player would trade per hit
+  const float threat_cost = 2.0;   // Per monster in range, per turn
+  const float infinity = 1e30;
+
+  struct Edge {
+    int target;    // State reached, or GOAL
+    float cost;
+  };
+  enum { NONE = -1, GOAL = -2 };
+
+  const Map* map;
+  int goal_x;
+  std::vector<int> state_of;       // Tile index -> state, or NONE
+  std::vector<Position> positions; // State -> tile
+  std::vector<Edge> edges;         // num_moves per state
+  std::vector<float> cost_to_go;
+  std::vector<int> best_move;
+
+  std::vector<Position> route;
+  std::vector<int> route_moves;
+
+  void Build();
+  int GetState(int x, int y) const;
+  float ThreatAt(const std::vector<Threat>& threats, Position position) const;
+  float RouteThreat(const std::vector<Threat>& threats, int start) const;
+  bool Rejoin(int start, const std::vector<Threat>& threats);
+  void Search(int start, const std::vector<Threat>& threats);
+  void FollowPolicy(int state);
+
+ public:
+  RoutePlanner();
+  void Reset(const Map* map, int goal_x);
+  bool Plan(int x, int y, const std::vector<Threat>& threats);
+  bool NextMove(int x, int y, int* dx, int* dy) const;
+  const std::vector<Position>& GetRoute() const { return route; };
+  static void GetMove(int move, int* dx, int* dy);
+};
+
+#endif /* INCLUDE_ROUTEPLANNER_H_ */
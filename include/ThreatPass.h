@@ -0,0 +1,55 @@
+/**
+ *  \brief
+ *
+ *  Copyright (C) 2017  Chaos-Dev
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef INCLUDE_THREATPASS_H_
+#define INCLUDE_THREATPASS_H_
+
+#include <cstdint>
+#include <vector>
+
+class Actor;
+class ActorStore;
+
+/** Decides which monsters can shoot at the player this turn.
+ *
+ *  Rather than having each monster work out its range on its own turn, the
+ *  positions and stats of all the monsters are gathered from the actor
+ *  store's arrays once per turn and checked together by
+ *  Ballistics::CheckRanges.  Only the few
+ *  monsters that can hit then have their line of fire checked.
+ *
+ *  This is only valid because the player stands still while the monsters
+ *  take their turns, and a monster only moves during its own turn.
+ */
+class ThreatPass {
+ protected:
+  std::vector<Actor*> monsters;   // In the order of the store's ai set
+  std::vector<int16_t> positions;  // x and y of each monster, in turn
+  std::vector<int> reach2;
+  std::vector<int> max_range;
+  std::vector<int> attack;
+  std::vector<int> distance2;      // Squared distance to the target
+  std::vector<uint8_t> in_range;
+
+ public:
+  void Update(const ActorStore& store, Actor* target);
+  bool InRange(Actor* monster, Actor* target) const;
+};
+
+#endif /* INCLUDE_THREATPASS_H_ */
@@ -17,17 +17,22 @@
  *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <string>
- 
+#ifndef INCLUDE_WORDS_H_
+#define INCLUDE_WORDS_H_
+
+// What an actor is called in the log.  These are shared between every
+// actor of a kind, so they are never changed once an actor has them.
 struct Words {
   const char* name;
   const char* Name;
   const char* corpse;
   const char* possessive;
-  std::string weapon;
-  std::string armor;
-  Words(const char* name, const char* Name, const char* corpse, 
+  const char* weapon;
+  const char* armor;
+  constexpr Words(const char* name, const char* Name, const char* corpse, 
         const char* possessive, const char* weapon, const char* armor)
     : name(name), Name(Name), corpse(corpse), possessive(possessive), 
       weapon(weapon), armor(armor) {};
 };
+
+#endif /* INCLUDE_WORDS_H_ */
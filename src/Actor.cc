@@ -30,17 +30,14 @@
  * @param symbol - An integer representing the ASCII number for the actor's symbol
  * @param name - A character array with the name of the actor
  */
+int Actor::next_id = 0;
+
 Actor::Actor(int x, int y, int symbol, Color color, int speed) :
-             x(x),y(y),symbol(symbol),ai(nullptr), item(nullptr),
+             id(next_id++), x(x),y(y),symbol(symbol),ai(nullptr), item(nullptr),
              destructible(nullptr), attacker(nullptr), words(nullptr),
-             blocks(true), color(color), speed(speed), can_fly(false) {
-};
-
-Actor::~Actor() {
-  if ( ai ) delete ai;
-  if ( destructible ) delete destructible;
-  if ( attacker ) delete attacker;
-  if ( words ) delete words;
+             archetype(-1), stats(nullptr),
+             blocks(true), color(color), speed(speed), can_fly(false),
+             render_layer(CREATURES), entity(-1) {
 };
 
 void Actor::Update() {
@@ -61,3 +58,11 @@ float Actor::GetDistance(int cx, int cy) const {
   int dy=y-cy;
   return std::sqrt(dx*dx+dy*dy);
 }
+
+/** Finds what the actor is called right now, which is its corpse once it
+ * has died.
+ */
+const char* Actor::GetName() const {
+  if (destructible && destructible->isDead()) return words->corpse;
+  return words->name;
+}
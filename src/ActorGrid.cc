@@ -0,0 +1,122 @@
+/**
+ *  \brief
+ *
+ *  Copyright (C) 2017  Chaos-Dev
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ActorGrid.h"
+
+#include <algorithm>
+
+#include "Actor.h"
+#include "ActorStore.h"
+
+/** Creates an empty grid.
+ *
+ * @param width - The width of the map, in tiles
+ * @param height - The height of the map, in tiles
+ */
+ActorGrid::ActorGrid(int width, int height)
+    : width(width), height(height), version(-1), store(nullptr) {
+  first.resize(width*height, -1);
+};
+
+/** Rebuilds the lists if the world has changed since they were built.
+ *
+ * @param store - Every actor on the level
+ * @param version - The engine's world version
+ */
+void ActorGrid::Update(const ActorStore& store, long version) {
+  if (version == this->version && &store == this->store) return;
+  this->version = version;
+  this->store = &store;
+
+  // Clear only the tiles that were used last time.  The actors may have
+  // moved or been removed since, so their old positions are kept separately.
+  for (int tile : used) first[tile] = -1;
+  used.clear();
+
+  // Sort the entities by render layer, counting them first.
+  int count = store.Size();
+  int start[Actor::NUM_RENDER_LAYERS+1] = {};
+  for (int entity=0; entity<count; entity++) start[store.layer[entity]+1]++;
+  for (int i=0; i<Actor::NUM_RENDER_LAYERS; i++) start[i+1] += start[i];
+  order.resize(count);
+  for (int entity=0; entity<count; entity++)
+    order[start[store.layer[entity]]++] = entity;
+  next.assign(count, -1);
+
+  // Add them back to front, so each list is in drawing order.
+  for (int i=count-1; i>=0; i--) {
+    int x = store.x[order[i]];
+    int y = store.y[order[i]];
+    if (x < 0 || x >= width || y < 0 || y >= height) continue;
+    int tile = x + y*width;
+    if (first[tile] < 0) used.push_back(tile);
+    next[i] = first[tile];
+    first[tile] = i;
+  }
+};
+
+/** Lists the actors on a tile.
+ *
+ * @param x - The x coordinate of the tile
+ * @param y - The y coordinate of the tile
+ * @param found - Cleared, then filled with the actors on the tile
+ */
+void ActorGrid::GetActors(int x, int y, std::vector<Actor*>& found) const {
+  found.clear();
+  if (x < 0 || x >= width || y < 0 || y >= height) return;
+  for (int i=first[x + y*width]; i >= 0; i = next[i])
+    found.push_back(store->actors[order[i]]);
+};
+
+/** Lists the actors in a rectangle of tiles, a row at a time.
+ *
+ * @param x0 - The left edge of the rectangle
+ * @param y0 - The bottom edge of the rectangle
+ * @param x1 - One past the right edge
+ * @param y1 - One past the top edge
+ * @param found - Cleared, then filled with the actors in the rectangle
+ */
+void ActorGrid::GetActorsIn(int x0, int y0, int x1, int y1,
+                            std::vector<Actor*>& found) const {
+  std::vector<int> entities;
+  GetEntitiesIn(x0, y0, x1, y1, entities);
+  found.clear();
+  for (int entity : entities) found.push_back(store->actors[entity]);
+};
+
+/** Lists the entities in a rectangle of tiles, a row at a time.
+ *
+ * @param x0 - The left edge of the rectangle
+ * @param y0 - The bottom edge of the rectangle
+ * @param x1 - One past the right edge
+ * @param y1 - One past the top edge
+ * @param found - Cleared, then filled with the entities in the rectangle
+ */
+void ActorGrid::GetEntitiesIn(int x0, int y0, int x1, int y1,
+                              std::vector<int>& found) const {
+  found.clear();
+  x0 = std::max(x0, 0); x1 = std::min(x1, width);
+  y0 = std::max(y0, 0); y1 = std::min(y1, height);
+  for (int y=y0; y<y1; y++) {
+    for (int x=x0; x<x1; x++) {
+      for (int i=first[x + y*width]; i >= 0; i = next[i])
+        found.push_back(order[i]);
+    }
+  }
+};
@@ -0,0 +1,226 @@
+/**
+ *  \brief
+ *
+ *  Copyright (C) 2017  Chaos-Dev
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "ActorStore.h"
+
+#include <algorithm>
+
+#include "Actor.h"
+
+/** Adds an entity to the set, if it isn't there already.
+ */
+void EntitySet::Insert(int entity) {
+  if (Contains(entity)) return;
+  if (entity >= (int)sparse.size()) sparse.resize(entity+1, -1);
+  sparse[entity] = dense.size();
+  dense.push_back(entity);
+};
+
+/** Takes an entity out of the set, moving the last one into its place.
+ */
+void EntitySet::Erase(int entity) {
+  if (!Contains(entity)) return;
+  int last = dense.back();
+  dense[sparse[entity]] = last;
+  sparse[last] = sparse[entity];
+  dense.pop_back();
+  sparse[entity] = -1;
+};
+
+/** Follows an entity that the store has moved to another position.
+ *
+ * @param from - The old entity, which must not be used again
+ * @param to - The new entity, which must not be in the set
+ */
+void EntitySet::Rename(int from, int to) {
+  if (!Contains(from)) return;
+  if (to >= (int)sparse.size()) sparse.resize(to+1, -1);
+  sparse[to] = sparse[from];
+  dense[sparse[to]] = to;
+  sparse[from] = -1;
+};
+
+bool EntitySet::Contains(int entity) const {
+  return entity < (int)sparse.size() && sparse[entity] >= 0;
+};
+
+/** Finds where an entity is in the dense list.
+ *
+ * @return The position, or -1 if it isn't in the set
+ */
+int EntitySet::IndexOf(int entity) const {
+  return Contains(entity) ? sparse[entity] : -1;
+};
+
+void EntitySet::Clear() {
+  dense.clear();
+  sparse.clear();
+};
+
+/** Creates an empty store.
+ *
+ * @param width - The width of the map, in tiles
+ * @param height - The height of the map, in tiles
+ */
+ActorStore::ActorStore(int width, int height)
+    : width(width), height(height) {
+  blockers.resize(width*height, 0);
+};
+
+/** Adds an actor, copying its hot fields into the arrays.
+ *
+ * @param actor - The actor, which keeps its cold data
+ * @param stats - Its combat stats, from Actor::GetStats if it can fight
+ * @return The actor's entity
+ */
+int ActorStore::Add(Actor* actor, const Stats& stats) {
+  int entity = actors.size();
+  actors.push_back(actor);
+  x.push_back(actor->x);
+  y.push_back(actor->y);
+  flags.push_back((actor->blocks ? BLOCKS : 0) | (actor->can_fly ? CAN_FLY : 0));
+  layer.push_back(actor->render_layer);
+  speed.push_back(actor->speed);
+  hp.push_back(actor->destructible ? actor->destructible->hp : 0);
+  attack.push_back(stats.attack);
+  dodge.push_back(stats.dodge);
+  max_range.push_back(stats.max_range);
+  symbol.push_back(actor->symbol);
+  color.push_back(actor->color.Convert());
+  if (actor->ai && actor->ai->type == Ai::MONSTER) ai.Insert(entity);
+  if (actor->item) item.Insert(entity);
+  if (actor->blocks) AddBlocker(actor->x, actor->y, 1);
+  return entity;
+};
+
+/** Takes an actor off the level.  The last actor takes its entity.
+ */
+void ActorStore::Remove(int entity) {
+  if (flags[entity] & BLOCKS) AddBlocker(x[entity], y[entity], -1);
+  ai.Erase(entity);
+  item.Erase(entity);
+  int last = actors.size() - 1;
+  if (entity != last) {
+    actors[entity] = actors[last];
+    x[entity] = x[last];
+    y[entity] = y[last];
+    flags[entity] = flags[last];
+    layer[entity] = layer[last];
+    speed[entity] = speed[last];
+    hp[entity] = hp[last];
+    attack[entity] = attack[last];
+    dodge[entity] = dodge[last];
+    max_range[entity] = max_range[last];
+    symbol[entity] = symbol[last];
+    color[entity] = color[last];
+    ai.Rename(last, entity);
+    item.Rename(last, entity);
+    actors[entity]->entity = entity;
+  }
+  actors.pop_back();
+  x.pop_back();
+  y.pop_back();
+  flags.pop_back();
+  layer.pop_back();
+  speed.pop_back();
+  hp.pop_back();
+  attack.pop_back();
+  dodge.pop_back();
+  max_range.pop_back();
+  symbol.pop_back();
+  color.pop_back();
+};
+
+void ActorStore::Move(int entity, int x, int y) {
+  if (flags[entity] & BLOCKS) {
+    AddBlocker(this->x[entity], this->y[entity], -1);
+    AddBlocker(x, y, 1);
+  }
+  this->x[entity] = x;
+  this->y[entity] = y;
+};
+
+void ActorStore::SetBlocks(int entity, bool blocks) {
+  if (bool(flags[entity] & BLOCKS) == blocks) return;
+  AddBlocker(x[entity], y[entity], blocks ? 1 : -1);
+  flags[entity] ^= BLOCKS;
+};
+
+/** Moves an actor to another render layer, and picks up any change to how
+ * it looks, as when it dies.
+ */
+void ActorStore::SetLayer(int entity, int layer) {
+  this->layer[entity] = layer;
+  symbol[entity] = actors[entity]->symbol;
+  color[entity] = actors[entity]->color.Convert();
+};
+
+void ActorStore::SetHp(int entity, int hp) {
+  this->hp[entity] = hp;
+};
+
+void ActorStore::SetStats(int entity, const Stats& stats) {
+  attack[entity] = stats.attack;
+  dodge[entity] = stats.dodge;
+  max_range[entity] = stats.max_range;
+};
+
+/** Takes every actor off the level, without deleting them.
+ */
+void ActorStore::Clear() {
+  for (Actor* actor : actors) actor->entity = -1;
+  actors.clear();
+  x.clear();
+  y.clear();
+  flags.clear();
+  layer.clear();
+  speed.clear();
+  hp.clear();
+  attack.clear();
+  dodge.clear();
+  max_range.clear();
+  symbol.clear();
+  color.clear();
+  ai.Clear();
+  item.Clear();
+  std::fill(blockers.begin(), blockers.end(), 0);
+};
+
+/** Checks whether any blocking actor is on a tile.
+ *
+ * @return True if nothing blocks it, including off the edge of the map
+ */
+bool ActorStore::CanWalk(int x, int y) const {
+  return CountBlockers(x, y) == 0;
+};
+
+/** Counts the blocking actors on a tile.
+ *
+ * @return The number of actors, or 0 off the edge of the map
+ */
+int ActorStore::CountBlockers(int x, int y) const {
+  if (x < 0 || x >= width || y < 0 || y >= height) return 0;
+  return blockers[x + y*width];
+};
+
+void ActorStore::AddBlocker(int x, int y, int count) {
+  if (x < 0 || x >= width || y < 0 || y >= height) return;
+  blockers[x + y*width] += count;
+};
@@ -28,13 +28,15 @@
 #include "Actor.h"
 #include "Engine.h"
 
-MonsterAi::MonsterAi() : active(false) {
+MonsterAi::MonsterAi() : Ai(MONSTER) {
 }
 
 /** Checks to see if a monster should be updated/considered this turn.
  *
  * If a monster is inactive, out of range, etc., we don't need to have them
  * move each turn.  This function checks to see if the monster is active.
+ * The engine's turn loop wakes monsters up as the player comes near, by
+ * setting their ACTIVE flag in the actor store.
  *
  * @param owner - The monster to be considered.
  * @return True indicates that the monster should be updated/considered.
@@ -43,14 +45,8 @@ bool MonsterAi::isActive(Actor *owner) {
   if (owner->destructible && owner->destructible->isDead()) {
     return false;
   }
-  if (active) {
-    return true;
-  } else if (std::abs(owner->x - engine.player->x) < 60) {
-    active = true;
-    return true;
-  } else {
-    return false;
-  }
+  if (owner->entity < 0) return false;
+  return engine.actor_store->flags[owner->entity] & ActorStore::ACTIVE;
 };
 
 void MonsterAi::ProcessInput(Actor *owner, int key, bool shift) {
@@ -63,7 +59,7 @@ void MonsterAi::ProcessInput(Actor *owner, int key, bool shift) {
  */
 void MonsterAi::Update(Actor *owner) {
   if (isActive(owner)) {
-    if (owner->attacker && owner->attacker->InRange(owner, engine.player) &&
+    if (owner->attacker && engine.threat_pass->InRange(owner, engine.player) &&
         !engine.player->destructible->isDead()) {
         owner->attacker->SetAim(engine.player);
         owner->attacker->UpdateFiring(owner);
@@ -97,17 +93,18 @@ void MonsterAi::moveOrAttack(Actor *owner, int targetx, int targety) {
         if (engine.map->CanWalk(owner->x+dx,owner->y+dy) && 
             (!engine.map->isWater(owner->x+dx,owner->y+dy) || 
             owner->can_fly)) {
-          owner->x += dx;
-          owner->y += dy;
+          engine.MoveActor(owner, owner->x+dx, owner->y+dy);
         } else if ( engine.map->CanWalk(owner->x+stepdx,owner->y) && 
                    (!engine.map->isWater(owner->x+stepdx,owner->y) || 
                    owner->can_fly)) {
-          owner->x += stepdx;
+          engine.MoveActor(owner, owner->x+stepdx, owner->y);
         } else if (engine.map->CanWalk(owner->x,owner->y+stepdy) && 
                    (!engine.map->isWater(owner->x,owner->y+stepdy) || 
                    owner->can_fly)) {
-          owner->y += stepdy;
-        } else if ( distance < std::min(owner->attacker->max_range,70) ) {
+          engine.MoveActor(owner, owner->x, owner->y+stepdy);
+        } else if ( distance < std::min(owner->GetStats().max_range,70) &&
+                    engine.fov->LineOfFire(*engine.map, owner->x, owner->y,
+                                           targetx, targety) ) {
           owner->attacker->SetAim(engine.player);
           owner->attacker->UpdateFiring(owner);
         }
@@ -119,7 +116,7 @@ void MonsterAi::moveOrAttack(Actor *owner, int targetx, int targety) {
 }
 
 
-PlayerAi::PlayerAi() : dx(0), dy(0), move(false) {
+PlayerAi::PlayerAi() : Ai(PLAYER), dx(0), dy(0), move(false) {
 }
 
 /** Checks to see if the player should be considered for effects, etc.
@@ -156,6 +153,7 @@ void PlayerAi::Update(Actor *owner) {
 
   // Process any movement
   if (move) {
+    engine.world_version++;
     if (moveOrAttack(owner, owner->x+dx,owner->y+dy))
       engine.game_status = Engine::NEW_TURN;
     engine.camera->x = owner->x; engine.camera->y = owner->y;
@@ -201,45 +199,55 @@ bool PlayerAi::moveOrAttack(Actor *owner, int targetx,int targety) {
                   (engine.player->y == engine.raft->y));
   if ( engine.map->isWall(targetx,targety) ) return false;
   
-  // look for living actors to attack
+  // look for living actors to attack.  The topmost render layer goes
+  // first, so a monster standing on an item is attacked rather than the
+  // item picked up.  Within a layer, the oldest actor goes first.
   bool attacking = false;
-  for (int i=0; i<engine.actors.size(); i++) {
-    Actor* actor = engine.actors[i];
-    if ( actor->x == targetx && actor->y == targety ) {
-      if (actor->destructible && !actor->destructible->isDead()
-          && actor != engine.player && actor != engine.raft) {
-        //Attack the monster
-        owner->attacker->Attack(owner, actor, -5);
-        attacking = true;
-        targetx = owner->x;
-        targety = owner->y;
+  std::vector<Actor*> found;
+  engine.GetActorsAt(targetx, targety, found);
+  std::sort(found.begin(), found.end(), [](Actor* a, Actor* b) {
+    if (a->render_layer != b->render_layer)
+      return a->render_layer > b->render_layer;
+    return a->id < b->id;
+  });
+  for (Actor* actor : found) {
+    if (actor->destructible && !actor->destructible->isDead()
+        && actor != engine.player && actor != engine.raft) {
+      //Attack the monster
+      owner->attacker->Attack(owner, actor, -5);
+      attacking = true;
+      targetx = owner->x;
+      targety = owner->y;
+      break;
+    } else if (actor->item) {
+       // Wield an item
+      if (actor->item->damage > owner->stats->mean_damage) {
+        engine.gui->log->Print("[color=dark orange]You are now wielding the %s.",
+                               actor->words->name);
+        owner->stats->mean_damage = actor->item->damage;
+        owner->stats->max_range = actor->item->max_range;
+        engine.actor_store->SetStats(owner->entity, *owner->stats);
+        engine.RemoveActor(actor);
+        // Words are shared, so the player gets an edited copy.
+        Words* words = engine.game_pool->New<Words>(*owner->words);
+        words->weapon = actor->words->weapon;
+        owner->words = words;
+        break;
+      } else if (actor->item->damage > 0) {
+        engine.gui->log->Print("[color=yellow]You already have that weapon!");
+        break;
+      } else if (actor->item->armor > owner->stats->armor) {
+        engine.gui->log->Print("[color=dark orange]You are now wearing the %s.",
+                               actor->words->name);
+        owner->stats->armor = actor->item->armor;
+        Words* words = engine.game_pool->New<Words>(*owner->words);
+        words->armor = actor->words->name;
+        owner->words = words;
+        engine.RemoveActor(actor);
+        break;
+      } else {
+        engine.gui->log->Print("[color=yellow]You already have that armor!");
         break;
-      } else if (actor->item) {
-         // Wield an item
-        if (actor->item->damage > owner->attacker->mean_damage) {
-          engine.gui->log->Print("[color=dark orange]You are now wielding the %s.",
-                                 actor->words->name);
-          owner->attacker->mean_damage = actor->item->damage;
-          owner->attacker->max_range = actor->item->max_range;
-          engine.actors.erase(engine.actors.begin()+i);
-          owner->words->weapon.replace(0,std::string::npos,actor->words->weapon);
-          delete actor;
-          break;
-        } else if (actor->item->damage > 0) {
-          engine.gui->log->Print("[color=yellow]You already have that weapon!");
-          break;
-        } else if (actor->item->armor > owner->destructible->armor) {
-          engine.gui->log->Print("[color=dark orange]You are now wearing the %s.",
-                                 actor->words->name);
-          owner->destructible->armor = actor->item->armor;
-          owner->words->armor.replace(0,std::string::npos,actor->words->name);
-          engine.actors.erase(engine.actors.begin()+i);
-          delete actor;
-          break;
-        } else {
-          engine.gui->log->Print("[color=yellow]You already have that armor!");
-          break;
-        }
       }
     }
   }
@@ -258,18 +266,9 @@ bool PlayerAi::moveOrAttack(Actor *owner, int targetx,int targety) {
   }
 
   
-  // I cheat a little here to give the player a favorable rounding
   int temp_x = owner->x; int temp_y = owner->y;
-  if (owner->x == targetx) {
-    owner->x=targetx + std::round(engine.map->GetUVelocity(owner->x, owner->y));
-  } else {
-    owner->x=targetx + std::trunc(engine.map->GetUVelocity(owner->x, owner->y));
-  }
-  if (owner->y == targety) {
-    owner->y=targety + std::round(engine.map->GetVVelocity(owner->x, owner->y));
-  } else {
-    owner->y=targety + std::trunc(engine.map->GetVVelocity(owner->x, owner->y));
-  }
+  Position drifted = engine.map->GetDrift(owner->x, owner->y, targetx, targety);
+  engine.MoveActor(owner, drifted.x, drifted.y);
   
   if (owner->x > engine.map->width-engine.NEXT_LEVEL_POINT) {
     engine.NextLevel();
@@ -284,14 +283,14 @@ bool PlayerAi::moveOrAttack(Actor *owner, int targetx,int targety) {
     if (moved && on_raft) CheckRaftDamage(owner, temp_x, temp_y);
     // We need this condition to ensure that the game doesn't reset to IDLE.
     if (engine.raft->destructible->isDead()) {
-        engine.raft->x = owner->x; engine.raft->y = owner->y;
+        engine.MoveActor(engine.raft, owner->x, owner->y);
         return false;
     }
     
     if (on_raft) {
       if (engine.map->isWater(targetx, targety)) {
         // Move the raft with the player.
-        engine.raft->x = owner->x; engine.raft->y = owner->y;
+        engine.MoveActor(engine.raft, owner->x, owner->y);
       } else {
         engine.gui->log->Print("You climb off the raft.");
       }
@@ -304,22 +303,18 @@ bool PlayerAi::moveOrAttack(Actor *owner, int targetx,int targety) {
   }
   
   // Check to make sure the river hasn't moved us onto any tiles we shouldn't be on...
-  for (Actor* actor : engine.actors) {
-    if ( actor->blocks && actor->x == owner->x && actor->y == owner->y ) {
+  engine.GetActorsAt(owner->x, owner->y, found);
+  for (Actor* actor : found) {
+    if ( actor->blocks ) {
       for (int i=0; i<9; i++) {
          int move_x = -i%3 + actor->x;
          int move_y = -i/3 + actor->y;
          if (engine.map->isWall(move_x,move_y)) continue;
-         bool free = true;
-         for (Actor* other_actor : engine.actors) {
-            if ( other_actor->blocks && other_actor != actor &&
-                 other_actor->x == move_x && other_actor->y == move_y) {
-              free = false;
-              break;
-            };
-         };
-         if (free) { 
-           actor->x = move_x; actor->y = move_y;
+         // Free if nothing else blocks it, not counting this actor.
+         int others = engine.actor_store->CountBlockers(move_x, move_y);
+         if (move_x == actor->x && move_y == actor->y) others--;
+         if (others == 0) { 
+           engine.MoveActor(actor, move_x, move_y);
            break;
          }
        }
@@ -329,20 +324,7 @@ bool PlayerAi::moveOrAttack(Actor *owner, int targetx,int targety) {
 }
 
 void PlayerAi::CheckRaftDamage(Actor *owner, int old_x, int old_y) {
-  int hits = 0;
-  float distance = owner->GetDistance(old_x, old_y);
-  float cos_theta = (owner->x - old_x)/distance;
-  float sin_theta = (owner->y - old_y)/distance;
-  float x = old_x; float y = old_y;
-  int temp_x = old_x; int temp_y = old_y;
-  float delta = distance/8.0;
-  while (std::abs(x - owner->x) > 1e-3 || std::abs(y - owner->y) > 1e-3) {
-    x+= delta*cos_theta; y+=delta*sin_theta;
-    if (std::round(x) != temp_x || std::round(y) != temp_y) {
-      temp_x = std::round(x); temp_y = std::round(y);
-      if (engine.map->isRock(temp_x,temp_y)) hits++;
-    }
-  };
+  int hits = engine.map->CountRocks(old_x, old_y, owner->x, owner->y);
   if (hits > 1) {
     engine.gui->log->Print("Your raft hits some rocks, and takes %d damage!",hits);
   } else if (hits == 1) {
@@ -20,22 +20,15 @@
 
 #include <algorithm>    // std::min
 #include <exception>
-#include <random>
 #include <cmath>
 
 #include "Actor.h"
+#include "Ballistics.h"
 #include "Engine.h"
 
 Attacker::Attacker() : firing(false) {
 };
 
-/** Allows initialization with combat attributes.
- */
-Attacker::Attacker(int attack, int dodge, int mean_damage, int max_range)
-    : attack(attack), dodge(dodge), mean_damage(mean_damage),
-      max_range(max_range), firing(false) {
-};
-
 /** This is the core functionality behind all attacks (melee, ranged, etc.)
  *
  * @param owner - A pointer to the actor who is attacking.
@@ -46,29 +39,44 @@ Attacker::Attacker(int attack, int dodge, int mean_damage, int max_range)
  *   the damage.
  */
 void Attacker::Attack(Actor *owner, Actor *target, int mod) {
-
-    std::normal_distribution<float> dist(owner->attacker->attack-3,
-                                         (owner->attacker->attack-3.0)/3);
-	int attack_roll = std::max(0,(int)dist(engine.rng));
-#ifndef NDEBUG
-        engine.gui->log->Print("[color=grey]The attack roll was: %d / %d", attack_roll, owner->attacker->attack);
-#endif
+	const Stats& stats = owner->GetStats();
+	CombatEvent event;
+	event.attacker_id = owner->id;
+	event.target_id = target->id;
+	event.attacker = owner;
+	event.target = target;
+	event.attack_roll = std::max(0,(int)engine.dice->Normal(
+	    stats.attack-3, (stats.attack-3.0)/3));
+	event.attack = stats.attack;
+	event.dodge = (target->attacker ? target->GetStats().dodge : 0);
+	event.mean_damage = stats.mean_damage;
+	event.dodge_roll = -1;
+	event.damage_roll = -1;
 	int damage = 0;
-	bool dodged = false;
-	bool hits = false;
-	bool penetrates = false;
 
-    hits = owner->attacker->DoesItHit(attack_roll, mod, target);
+    bool hits = owner->attacker->DoesItHit(event.attack_roll, mod, target,
+                                           &event.dodge_roll);
 	if (hits) {
-		damage = owner->attacker->GetDamage(owner->attacker->mean_damage, 0, target);
-		if (damage > 0) penetrates = true;
-	    damage = std::min(target->destructible->hp,damage);
-    } else if (attack_roll > 10) {
-        dodged = true;
+		damage = owner->attacker->GetDamage(stats.mean_damage, 0,
+		                                    target, &event.damage_roll);
+	    if (target->destructible)
+	        damage = std::min(target->destructible->hp,damage);
     }
-    
-	owner->attacker->Message(hits,penetrates,dodged,damage,owner,target);
-	//Taking damage must happen after the message is displayed. Otherwise the
+
+	if (!target->destructible) {
+		event.outcome = CombatEvent::IN_VAIN;
+	} else if (!hits && event.attack_roll > 10) {
+		event.outcome = CombatEvent::DODGED;
+	} else if (damage > 0) {
+		event.outcome = CombatEvent::HIT;
+	} else if (!hits) {
+		event.outcome = CombatEvent::MISSED;
+	} else {
+		event.outcome = CombatEvent::BOUNCED;
+	}
+	event.damage = std::max(0, damage);
+	engine.combat_log->Add(event, engine.turn);
+	//Taking damage must happen after the event is recorded. Otherwise the
 	//  messages about leveling up, killing, etc. happen before the attack
 	//  messages. This would also lead to the killing blow reading
 	//  "[name] deals 4 damage to [corpse]"
@@ -84,17 +92,15 @@ void Attacker::Attack(Actor *owner, Actor *target, int mod) {
  *
  * @param dice - An integer representing the combat "roll", plus modifiers
  * @param target - A pointer to the actor being attacked
+ * @param[out] dodge_roll - The target's roll, if they had one
  * @return True if the attack successfully hits the target
  */
-bool Attacker::DoesItHit(int attack_roll, int mod, Actor *target) {
+bool Attacker::DoesItHit(int attack_roll, int mod, Actor *target,
+                         int *dodge_roll) {
 	if (target->attacker) {
-	    std::normal_distribution<float> dist(target->attacker->dodge-3,
-                                             (target->attacker->dodge-3.0)/3);
-        int dodge_roll = std::max(0,(int)dist(engine.rng));
-#ifndef NDEBUG
-        engine.gui->log->Print("[color=grey]The dodge roll was: %d / %d", dodge_roll, target->attacker->dodge);
-#endif
-        if (attack_roll > dodge_roll + mod) {
+        *dodge_roll = std::max(0,(int)engine.dice->Normal(
+            target->GetStats().dodge-3, (target->GetStats().dodge-3.0)/3));
+        if (attack_roll > *dodge_roll + mod) {
             return true;
         } else {
             return false;
@@ -104,64 +110,24 @@ bool Attacker::DoesItHit(int attack_roll, int mod, Actor *target) {
 	};
 };
 
-void Attacker::Message(bool hits, bool penetrates, bool dodged, int damage, Actor *owner, Actor *target) {
-	if (target->destructible) {
-	    if ( dodged ) {
-		    const char* temp_word = ((owner == engine.player)? "r" : "'s");
-		    const char* temp_word2 = ((target == engine.player)? "dodge" : "dodges");
-			engine.gui->log->Print("%s %s away from %s%s %s.",
-			                       target->words->Name, temp_word2,
-			                       owner->words->name, temp_word, 
-			                       owner->words->weapon.c_str());
-	    } else if ( penetrates ) {
-		    const char* temp_word = ((owner == engine.player)? "hit" : "hits");
-			engine.gui->log->Print("%s %s %s with %s %s, dealing %d damage.", 
-			                       owner->words->Name,
-			                       temp_word,
-			                       target->words->name, 
-			                       owner->words->possessive,
-			                       owner->words->weapon.c_str(), damage);
-		} else if ( !hits ) {
-		    const char* temp_word = ((owner == engine.player)? "miss" : "misses");
-			engine.gui->log->Print("%s %s %s with %s %s.",
-			                       owner->words->Name, temp_word,
-			                       target->words->name, 
-			                       owner->words->possessive,
-			                       owner->words->weapon.c_str());
-		} else if ( !penetrates ) {
-		    const char* temp_word = ((owner == engine.player)? "r" : "'s");
-		    const char* temp_word2 = ((target == engine.player)? "r" : "'s");
-			engine.gui->log->Print("%s%s attack bounces off %s%s %s.",
-			                       owner->words->Name, temp_word,
-			                       target->words->name, temp_word2, 
-			                       target->words->armor.c_str());
-		};
-	} else {
-		engine.gui->log->Print("%s attacks %s in vain.",
-		                       owner->words->Name,
-			                     target->words->name);
-	};
-};
-
-int Attacker::GetDamage(int mean_damage, int mod, Actor* target) {
-    std::normal_distribution<float> dist(mean_damage, mean_damage/3);
-    int damage = (int)std::max(0, (int)dist(engine.rng));
-#ifndef NDEBUG
-        engine.gui->log->Print("[color=grey]The damage roll was: %d / %d", damage, mean_damage);
-#endif
+int Attacker::GetDamage(int mean_damage, int mod, Actor* target,
+                        int *damage_roll) {
+    int damage = (int)std::max(0,
+        (int)engine.dice->Normal(mean_damage, mean_damage/3));
+    *damage_roll = damage;
     if (target->destructible)
-        damage -= target->destructible->armor;
+        damage -= target->GetStats().armor;
     return damage;
 };
 
 int Attacker::GetRangeModifier(Actor* owner, Actor* target) {
+    int max_range = owner->GetStats().max_range;
     if (max_range == 0) {
         return -5;
     } else {
-        float distance = owner->GetDistance(target->x, target->y);
-        int modifier = int(15.0*std::log(distance)/
-                           std::log(float(owner->attacker->max_range)) - 5.0);
-        return modifier;
+        int dx = owner->x - target->x;
+        int dy = owner->y - target->y;
+        return Ballistics::RangeModifier(dx*dx + dy*dy, max_range);
     };
         
 };
@@ -184,17 +150,30 @@ bool Attacker::UpdateFiring(Actor* owner) {
   return false;
 };
 
+/** Checks to see if the owner can shoot at the target.
+ *
+ * The monsters' turns use ThreatPass, which does the same checks for all of
+ * them at once.
+ */
 bool Attacker::InRange(Actor* owner, Actor* target) {
-  float distance = owner->GetDistance(target->x, target->y);
-  if (max_range <= 1) {
+  int dx = owner->x - target->x;
+  int dy = owner->y - target->y;
+  int distance2 = dx*dx + dy*dy;
+  const Stats& stats = owner->GetStats();
+  int reach = std::min(70,stats.max_range);
+  if (stats.max_range <= 1) {
+    return false;
+  } else if (distance2 > reach*reach) {
     return false;
-  } else if (distance > std::min(70,owner->attacker->max_range)) {
+  } else if (!engine.fov->LineOfFire(*engine.map, owner->x, owner->y,
+                                     target->x, target->y)) {
+    // Rocks and walls block the shot.
     return false;
-  } else if (distance <= 3) {
+  } else if (distance2 <= 3*3) {
     return true;
   } else if (target->attacker) {
     int modifier = GetRangeModifier(owner, target);
-    if (target->attacker->dodge + modifier < owner->attacker->attack) {
+    if (target->GetStats().dodge + modifier < stats.attack) {
         return true;
     }
   }
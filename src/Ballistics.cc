@@ -0,0 +1,136 @@
+/**
+ *  \brief
+ *
+ *  Copyright (C) 2017  Chaos-Dev
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Ballistics.h"
+
+#include <algorithm>
+#include <cmath>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+const int Ballistics::max_reach;
+
+// Squared distances and ranges up to these are looked up rather than
+// passed to std::log.  They cover every shot a monster can take.
+static const int LOG_DISTANCE2_SIZE = 70*70 + 1;
+static const int LOG_RANGE_SIZE = 256;
+
+struct LogTables {
+  float log_distance[LOG_DISTANCE2_SIZE];  // log(sqrt(i))
+  float log_range[LOG_RANGE_SIZE];         // log(i)
+  LogTables() {
+    for (int i=0; i<LOG_DISTANCE2_SIZE; i++)
+      log_distance[i] = std::log(float(std::sqrt(i)));
+    for (int i=0; i<LOG_RANGE_SIZE; i++)
+      log_range[i] = std::log(float(i));
+  }
+};
+
+static const LogTables log_tables;
+
+/** Finds how far away a shooter can shoot from, squared.
+ *
+ * @param max_range - The shooter's maximum range
+ * @return The squared reach, or -1 if the shooter can only fight in melee
+ */
+int Ballistics::Reach2(int max_range) {
+  if (max_range <= 1) return -1;
+  int reach = std::min(max_reach, max_range);
+  return reach*reach;
+};
+
+/** Gives the penalty for shooting at a distance.
+ *
+ * @param distance2 - The squared distance to the target
+ * @param max_range - The shooter's maximum range, which must not be 0
+ * @return An amount added to the target's dodge
+ */
+int Ballistics::RangeModifier(int distance2, int max_range) {
+  float log_distance = (distance2 < LOG_DISTANCE2_SIZE ?
+                        log_tables.log_distance[distance2] :
+                        std::log(float(std::sqrt(distance2))));
+  float log_range = (max_range < LOG_RANGE_SIZE ?
+                     log_tables.log_range[max_range] :
+                     std::log(float(max_range)));
+  return int(15.0*log_distance/log_range - 5.0);
+};
+
+// Decides whether a shooter within reach is likely enough to hit.
+static inline bool CanHit(int distance2, int max_range, int attack,
+                          bool target_dodges, int target_dodge) {
+  if (distance2 <= 3*3) return true;
+  return target_dodges &&
+      target_dodge + Ballistics::RangeModifier(distance2, max_range) < attack;
+}
+
+/** Checks which shooters are in range of a target and likely to hit it.
+ *
+ * This follows Attacker::InRange, except for the line of fire, which is
+ * left to the caller.  Only the shooters within reach go on to the range
+ * modifier, which is usually a small fraction of them.
+ *
+ * @param positions - Each shooter's x and y, one after the other
+ * @param reach2 - Each shooter's squared reach, from Reach2
+ * @param max_range - Each shooter's maximum range
+ * @param attack - Each shooter's attack
+ * @param n - The number of shooters
+ * @param target_x - The x coordinate of the target
+ * @param target_y - The y coordinate of the target
+ * @param target_dodges - False if the target has no attacker to dodge with
+ * @param target_dodge - The target's dodge
+ * @param[out] distance2 - Each shooter's squared distance to the target
+ * @param[out] can_hit - True for each shooter that should take the shot
+ */
+void Ballistics::CheckRanges(const int16_t* positions, const int* reach2,
+                             const int* max_range, const int* attack, int n,
+                             int target_x, int target_y, bool target_dodges,
+                             int target_dodge, int* distance2,
+                             uint8_t* can_hit) {
+  int i = 0;
+#ifdef __SSE2__
+  // Each 32-bit lane holds one shooter's x and y as 16-bit halves, so one
+  // multiply-add gives dx*dx + dy*dy for four shooters.
+  __m128i target = _mm_set1_epi32((int)((uint32_t)(uint16_t)target_y << 16 |
+                                        (uint16_t)target_x));
+  for (; i+4 <= n; i += 4) {
+    __m128i xy = _mm_loadu_si128((const __m128i*)(positions + 2*i));
+    __m128i delta = _mm_sub_epi16(xy, target);
+    __m128i d2 = _mm_madd_epi16(delta, delta);
+    _mm_storeu_si128((__m128i*)(distance2 + i), d2);
+    __m128i reach = _mm_loadu_si128((const __m128i*)(reach2 + i));
+    __m128i too_far = _mm_cmpgt_epi32(d2, reach);
+    int in_reach = ~_mm_movemask_ps(_mm_castsi128_ps(too_far)) & 0xF;
+    for (int j=0; j<4; j++) {
+      can_hit[i+j] = ((in_reach >> j) & 1) &&
+          CanHit(distance2[i+j], max_range[i+j], attack[i+j], target_dodges,
+                 target_dodge);
+    }
+  }
+#endif
+  for (; i<n; i++) {
+    int dx = positions[2*i] - target_x;
+    int dy = positions[2*i+1] - target_y;
+    distance2[i] = dx*dx + dy*dy;
+    can_hit[i] = distance2[i] <= reach2[i] &&
+        CanHit(distance2[i], max_range[i], attack[i], target_dodges,
+               target_dodge);
+  }
+};
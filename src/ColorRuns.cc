@@ -0,0 +1,66 @@
+/**
+ *  \brief
+ *
+ *  Copyright (C) 2017  Chaos-Dev
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "ColorRuns.h"
+
+#include <algorithm>
+
+/** Splits each row into runs of tiles with the same colour.
+ *
+ * @param colors - The colour of each tile, a row at a time
+ * @param water - Whether each tile is water, which is never joined into runs
+ * @param width - The number of tiles in a row
+ * @param height - The number of rows
+ */
+void ColorRuns::Build(const std::vector<color_t>& colors,
+                      const std::vector<bool>& water, int width, int height) {
+  runs.clear();
+  row_runs.resize(height+1);
+  for (int y=0; y<height; y++) {
+    row_runs[y] = runs.size();
+    for (int x=0; x<width; x++) {
+      int i = x + y*width;
+      if (!water[i] && (int)runs.size() > row_runs[y] && !runs.back().water &&
+          colors[i] == colors[runs.back().start + y*width]) {
+        runs.back().end = x+1;
+      } else {
+        runs.push_back(ColorRun(x, x+1, water[i]));
+      }
+    }
+  }
+  row_runs[height] = runs.size();
+};
+
+/** Finds the run containing a tile, with a binary search of its row.
+ *
+ * @param y - The row
+ * @param x - The tile in the row, which must be on the map
+ * @return The run, which can be stepped forward until RowEnd(y)
+ */
+const ColorRun* ColorRuns::Find(int y, int x) const {
+  const ColorRun* row_begin = runs.data() + row_runs[y];
+  const ColorRun* row_end = runs.data() + row_runs[y+1];
+  return std::upper_bound(row_begin, row_end, x,
+      [](int x, const ColorRun& run) { return x < run.start; }) - 1;
+};
+
+const ColorRun* ColorRuns::RowEnd(int y) const {
+  return runs.data() + row_runs[y+1];
+};
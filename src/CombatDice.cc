@@ -0,0 +1,98 @@
+/**
+ *  \brief
+ *
+ *  Copyright (C) 2017  Chaos-Dev
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CombatDice.h"
+
+#include <cmath>
+
+static inline uint64_t RotateLeft(uint64_t x, int k) {
+  return (x << k) | (x >> (64 - k));
+};
+
+CombatDice::CombatDice() {
+  Seed(0);
+};
+
+/** Starts a new sequence of rolls.
+ *
+ * The state is filled with splitmix64, as the generator's authors suggest,
+ * so that similar seeds still give unrelated sequences.
+ *
+ * @param seed - Any number, e.g. drawn from the engine's generator.
+ */
+void CombatDice::Seed(uint64_t seed) {
+  for (int i=0; i<4; i++) {
+    uint64_t z = (seed += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    state[i] = z ^ (z >> 31);
+  }
+  next_normal = BATCH_SIZE;
+};
+
+/** Advances xoshiro256** by one step.
+ */
+uint64_t CombatDice::Next() {
+  uint64_t result = RotateLeft(state[1] * 5, 7) * 9;
+  uint64_t t = state[1] << 17;
+  state[2] ^= state[0];
+  state[3] ^= state[1];
+  state[1] ^= state[2];
+  state[0] ^= state[3];
+  state[2] ^= t;
+  state[3] = RotateLeft(state[3], 45);
+  return result;
+};
+
+/** Rolls a number in [0, 1).
+ */
+float CombatDice::Uniform() {
+  return (Next() >> 40) * (1.0f / (uint64_t(1) << 24));
+};
+
+/** Makes a whole batch of standard normal variates.
+ *
+ * The uniform numbers are drawn first, so the transform runs as a separate
+ * loop with no calls into the generator, which the compiler can vectorize.
+ */
+void CombatDice::FillNormals() {
+  const float two_pi = 6.28318530718f;
+  float u[BATCH_SIZE];
+  for (int i=0; i<BATCH_SIZE; i++) {
+    // (0, 1], so the logarithm below is never taken of zero.
+    u[i] = ((Next() >> 40) + 1) * (1.0f / (uint64_t(1) << 24));
+  }
+  for (int i=0; i<BATCH_SIZE/2; i++) {
+    float r = std::sqrt(-2.0f * std::log(u[2*i]));
+    float theta = two_pi * u[2*i+1];
+    normals[2*i] = r * std::cos(theta);
+    normals[2*i+1] = r * std::sin(theta);
+  }
+  next_normal = 0;
+};
+
+/** Rolls a normally distributed number.
+ *
+ * @param mean - The center of the distribution
+ * @param stddev - The standard deviation of the distribution
+ */
+float CombatDice::Normal(float mean, float stddev) {
+  if (next_normal == BATCH_SIZE) FillNormals();
+  return mean + stddev * normals[next_normal++];
+};
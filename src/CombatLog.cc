@@ -0,0 +1,125 @@
+/**
+ *  \brief
+ *
+ *  Copyright (C) 2017  Chaos-Dev
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "CombatLog.h"
+
+#include "Actor.h"
+#include "Engine.h"
+#include "Gui.h"
+
+CombatLog::CombatLog(Log* log)
+    : log(log), num_written(0), turn(-1), flushing(false), text_enabled(true) {
+};
+
+/** Records an attack.
+ *
+ * The events from the previous turn are written out and dropped when the
+ * first attack of a new turn comes in.
+ *
+ * @param event - The attack
+ * @param turn - The turn the attack happened on
+ */
+void CombatLog::Add(const CombatEvent& event, int turn) {
+  if (turn != this->turn) {
+    EndTurn();
+    this->turn = turn;
+  }
+  events.push_back(event);
+};
+
+/** Writes out the turn's attacks and drops them, along with their pointers
+ * to the actors involved.
+ */
+void CombatLog::EndTurn() {
+  Flush();
+  events.clear();
+  num_written = 0;
+};
+
+/** Writes any attacks that haven't been written to the log yet.
+ */
+void CombatLog::Flush() {
+  // Writing an event prints to the log, which flushes the combat log again.
+  if (flushing) return;
+  flushing = true;
+  while (num_written < events.size()) {
+    const CombatEvent& event = events[num_written++];
+    if (text_enabled) Write(event);
+  }
+  flushing = false;
+};
+
+void CombatLog::Write(const CombatEvent& event) {
+  const Actor* owner = event.attacker;
+  const Actor* target = event.target;
+#ifndef NDEBUG
+  log->Print("[color=grey]The attack roll was: %d / %d", event.attack_roll,
+             event.attack);
+  if (event.dodge_roll >= 0)
+    log->Print("[color=grey]The dodge roll was: %d / %d", event.dodge_roll,
+               event.dodge);
+  if (event.damage_roll >= 0)
+    log->Print("[color=grey]The damage roll was: %d / %d", event.damage_roll,
+               event.mean_damage);
+#endif
+  switch (event.outcome) {
+    case CombatEvent::DODGED: {
+      const char* temp_word = ((owner == engine.player)? "r" : "'s");
+      const char* temp_word2 = ((target == engine.player)? "dodge" : "dodges");
+      log->Print("%s %s away from %s%s %s.",
+                 target->words->Name, temp_word2,
+                 owner->words->name, temp_word,
+                 owner->words->weapon);
+      break;
+    }
+    case CombatEvent::HIT: {
+      const char* temp_word = ((owner == engine.player)? "hit" : "hits");
+      log->Print("%s %s %s with %s %s, dealing %d damage.",
+                 owner->words->Name,
+                 temp_word,
+                 target->words->name,
+                 owner->words->possessive,
+                 owner->words->weapon, event.damage);
+      break;
+    }
+    case CombatEvent::MISSED: {
+      const char* temp_word = ((owner == engine.player)? "miss" : "misses");
+      log->Print("%s %s %s with %s %s.",
+                 owner->words->Name, temp_word,
+                 target->words->name,
+                 owner->words->possessive,
+                 owner->words->weapon);
+      break;
+    }
+    case CombatEvent::BOUNCED: {
+      const char* temp_word = ((owner == engine.player)? "r" : "'s");
+      const char* temp_word2 = ((target == engine.player)? "r" : "'s");
+      log->Print("%s%s attack bounces off %s%s %s.",
+                 owner->words->Name, temp_word,
+                 target->words->name, temp_word2,
+                 target->words->armor);
+      break;
+    }
+    case CombatEvent::IN_VAIN:
+      log->Print("%s attacks %s in vain.",
+                 owner->words->Name,
+                 target->words->name);
+      break;
+  }
+};
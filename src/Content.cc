@@ -0,0 +1,64 @@
+/**
+ *  \brief
+ *
+ *  Copyright (C) 2017  Chaos-Dev
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Content.h"
+
+#include <algorithm>
+
+#include "Map.h"
+// Generated from data/content.txt when the game is built
+#include "ContentTables.h"
+
+/** Looks up the data for a level.
+ *
+ * @param level - The level, starting from 1.  Anything past the last level
+ *   gets the last level's data.
+ */
+const LevelData& LevelData::Get(int level) {
+  const int num_levels = sizeof(level_table)/sizeof(level_table[0]);
+  return level_table[std::min(std::max(level, 1), num_levels) - 1];
+};
+
+/** Picks the archetype for a new monster of some kind.
+ *
+ * @param monster_type - A Map::MonsterType
+ * @param roll - A random number, used to pick one of the variants
+ * @return The index of the archetype, for Get
+ */
+int Archetype::Find(int monster_type, int roll) {
+  const int* variants = monster_variants[monster_type];
+  return variants[0] + roll % variants[1];
+};
+
+/** Looks up the data for a kind of monster.
+ *
+ * @param index - An index from Find
+ * @return The archetype, which lasts for the whole game
+ */
+const Archetype& Archetype::Get(int index) {
+  return archetype_table[index];
+};
+
+/** Looks up the data for a kind of item.
+ *
+ * @param item_type - A Map::ItemType
+ */
+const ItemData& ItemData::Get(int item_type) {
+  return item_table[item_type];
+};
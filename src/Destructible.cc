@@ -23,13 +23,14 @@
 #include "Gui.h"
 #include "Engine.h"
 
-Destructible::Destructible(int maxHp, int armor) :
-	maxHp(maxHp),hp(maxHp),armor(armor) {
+Destructible::Destructible(int maxHp) :
+	maxHp(maxHp),hp(maxHp) {
 }
 
 int Destructible::takeDamage(Actor *owner, int damage) {
 	if ( damage > 0 ) {
 		hp -= damage;
+		if ( owner->entity >= 0 ) engine.actor_store->SetHp(owner->entity, hp);
 		if ( hp <= 0 ) {
 			die(owner);
 		}
@@ -49,32 +50,28 @@ int Destructible::heal(float amount) {
 }
 
 void Destructible::die(Actor *owner) {
-	// transform the actor into a corpse!
-	owner->words->name=owner->words->corpse;
-	owner->blocks=false;
+	// transform the actor into a corpse! GetName now gives the corpse
+	engine.SetBlocks(owner, false);
 
 	// make sure corpses are drawn before living actors
-	for (unsigned int i=0; i<engine.actors.size(); i++) {
-	    if (engine.actors[i] == owner) engine.actors.erase(engine.actors.begin()+i);
-	}
-	engine.actors.push_front(owner);
+	engine.SetRenderLayer(owner, Actor::CORPSES);
 }
 
-MonsterDestructible::MonsterDestructible(int maxHp, int armor) :
-	Destructible(maxHp,armor) {
+MonsterDestructible::MonsterDestructible(int maxHp) :
+	Destructible(maxHp) {
 }
 
 void MonsterDestructible::die(Actor *owner) {
-	// transform it into a nasty corpse! it doesn't block, can't be
-	// attacked and doesn't move
+	// leave a nasty corpse on the map, and take the monster off the level,
+	// so it doesn't slow down every turn from now on
 	engine.gui->log->Print("%s dies!", owner->words->Name);
-    owner->symbol='%';
-	owner->color=Color(136,13,3);
-	Destructible::die(owner);
+	engine.map->AddDecal(owner->x, owner->y, '%', Color(136,13,3),
+	                     owner->words->corpse);
+	engine.RemoveActor(owner);
 }
 
-PlayerDestructible::PlayerDestructible(int maxHp, int armor) :
-	Destructible(maxHp,armor) {
+PlayerDestructible::PlayerDestructible(int maxHp) :
+	Destructible(maxHp) {
 }
 
 void PlayerDestructible::die(Actor *owner) {
@@ -83,16 +80,12 @@ void PlayerDestructible::die(Actor *owner) {
 	owner->color=Color(136,13,3);
 	Destructible::die(owner);
 	// make sure your corpse is on top
-	for (unsigned int i=0; i<engine.actors.size(); i++) {
-	    if (engine.actors[i] == owner) engine.actors.erase(engine.actors.begin()+i);
-	    break;
-	}
-	engine.actors.push_back(owner);
+	engine.SetRenderLayer(owner, Actor::PLAYER);
 	engine.game_status=Engine::DEFEAT;
 }
 
-RaftDestructible::RaftDestructible(int maxHp, int armor) :
-	Destructible(maxHp,armor) {
+RaftDestructible::RaftDestructible(int maxHp) :
+	Destructible(maxHp) {
 }
 
 void RaftDestructible::die(Actor *owner) {
@@ -104,16 +97,11 @@ void RaftDestructible::die(Actor *owner) {
 	engine.game_status=Engine::DEFEAT;
 }
 
-GhostDestructible::GhostDestructible(int maxHp, int armor) :
-	Destructible(maxHp,armor) {
+GhostDestructible::GhostDestructible(int maxHp) :
+	Destructible(maxHp) {
 }
 
 void GhostDestructible::die(Actor *owner) {
 	engine.gui->log->Print("%s shrieks and fades away.", owner->words->Name);
-	for (unsigned int i=0; i<engine.actors.size(); i++) {
-	    if (engine.actors[i] == owner) {
-	        engine.actors.erase(engine.actors.begin()+i);
-	        break;
-	    }
-	}
+	engine.RemoveActor(owner);
 }
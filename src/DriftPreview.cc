@@ -0,0 +1,92 @@
+/**
+ *  \brief
+ *
+ *  Copyright (C) 2017  Chaos-Dev
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "DriftPreview.h"
+
+#include "BearLibTerminal.h"
+#include "Engine.h"
+
+DriftPreview::DriftPreview() : dirty(true), enabled(false) {
+};
+
+/** Forces the paths to be projected again, e.g. after a level change.
+ */
+void DriftPreview::Invalidate() {
+  dirty = true;
+};
+
+/** Projects the raft's path from the given position, if it has changed.
+ *
+ * @param map - The current level.
+ * @param x - The x coordinate of the raft
+ * @param y - The y coordinate of the raft
+ */
+void DriftPreview::Update(const Map& map, int x, int y) {
+  if (!dirty && origin.x == x && origin.y == y) return;
+  origin = Position(x, y);
+  dirty = false;
+  steps.clear();
+  for (int dx=-1; dx<=1; dx++) {
+    for (int dy=-1; dy<=1; dy++) {
+      AddPath(map, dx, dy);
+    }
+  }
+};
+
+/** Follows the current for one candidate move.
+ *
+ * The first turn is the move itself, and the player holds position for the
+ * rest.  The path stops once the raft would leave the water.
+ */
+void DriftPreview::AddPath(const Map& map, int dx, int dy) {
+  if (!map.isWater(origin.x+dx, origin.y+dy)) return;
+  Position from = origin;
+  Position to = map.GetDrift(origin.x, origin.y, origin.x+dx, origin.y+dy);
+  for (int turn=0; turn<turns; turn++) {
+    if (!map.isWater(to.x, to.y)) return;
+    bool hits_rock = map.CountRocks(from.x, from.y, to.x, to.y) > 0;
+    steps.push_back(Step(to, turn, hits_rock));
+    from = to;
+    to = map.GetDrift(from.x, from.y, from.x, from.y);
+    if (to.x == from.x && to.y == from.y) return;
+  }
+};
+
+/** Draws the projected paths on the current layer.
+ *
+ * Later turns are drawn fainter, and any turn that ends with the raft
+ * hitting a rock is marked in red.
+ */
+void DriftPreview::Render(Panel panel, Position* camera) const {
+  for (const Step& step : steps) {
+    int term_x = (step.position.x - camera->x)*2 + panel.width/2;
+    int term_y = -step.position.y + camera->y + panel.height/2;
+    if (term_x < 0 || term_y < 0 ||
+        term_x >= panel.width-1 || term_y >= panel.height) continue;
+    int alpha = 255 - step.turn*(160/turns);
+    if (step.hits_rock) {
+      terminal_color(color_from_argb(alpha, 220, 40, 30));
+      terminal_put(term_x, term_y, engine.TILE_CODE + 'x');
+    } else {
+      terminal_color(color_from_argb(alpha, 250, 250, 210));
+      terminal_put(term_x, term_y, engine.TILE_CODE + '.');
+    }
+  }
+  terminal_color(color_from_name("white"));
+};
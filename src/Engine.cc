@@ -18,6 +18,8 @@
 
 #include "Engine.h"
 
+#include <algorithm>
+#include <cstdlib>
 #include <iostream>
 
 #include "Actor.h"
@@ -27,13 +29,16 @@
 
 #include "BearLibTerminal.h"
 
-Engine::Engine() : status(OPEN), game_status(STARTUP), level(1), 
-    player(nullptr), raft(nullptr), map(nullptr) {
+Engine::Engine() : planned_turn(-1), level(1), turn(0), player(nullptr),
+    raft(nullptr), map(nullptr), combat_log(nullptr), dice(nullptr),
+    show_route(false), world_version(0), game_status(STARTUP), status(OPEN) {
   terminal_open();
   // Terminal settings
   terminal_set("window: title='Rogue River: Obol of Charon', resizeable=true, size=132x43, minimum-size=80x24");
   terminal_set("font: graphics/VeraMono.ttf, size=8x16");
-  terminal_set("tile font: graphics/Anikki_square_16x16.bmp, codepage=437, size=16x16, align=top-left");
+  // The tiles are loaded as a block of codes rather than a named font, so
+  // they can be drawn with terminal_put and no markup.
+  terminal_set("U+E000: graphics/Anikki_square_16x16.bmp, size=16x16, align=top-left");
   terminal_set("input.filter={keyboard, mouse+}, precise-mouse=true");
   terminal_composition(TK_ON);
   terminal_bkcolor("black");
@@ -45,11 +50,33 @@ Engine::Engine() : status(OPEN), game_status(STARTUP), level(1),
   mouse = new Position(terminal_state(TK_MOUSE_X), terminal_state(TK_MOUSE_Y));
 
   gui = new Gui(SIDEBAR_WIDTH);
+  combat_log = new CombatLog(gui->log);
+  dice = new CombatDice();
+  fov = new Fov(FOV_RADIUS);
+  drift_preview = new DriftPreview();
+  route_planner = new RoutePlanner();
+  threat_pass = new ThreatPass();
+  actor_store = new ActorStore(MAP_WIDTH, MAP_HEIGHT);
+  actor_grid = new ActorGrid(MAP_WIDTH, MAP_HEIGHT);
+  overview = new Overview();
+  level_pool = new Pool();
+  game_pool = new Pool();
 };
 
 Engine::~Engine() {
   Term();
+  if (combat_log) delete combat_log;
+  if (dice) delete dice;
   if (gui) delete gui;
+  if (fov) delete fov;
+  if (drift_preview) delete drift_preview;
+  if (route_planner) delete route_planner;
+  if (threat_pass) delete threat_pass;
+  if (actor_store) delete actor_store;
+  if (actor_grid) delete actor_grid;
+  if (overview) delete overview;
+  if (level_pool) delete level_pool;
+  if (game_pool) delete game_pool;
   terminal_close();
 };
 
@@ -57,41 +84,50 @@ void Engine::Init() {
   level=1;
   // Seed RNG
   rng.seed(std::random_device()());
+  dice->Seed(rng());
 
   // Initialize members
   map = new Map(MAP_WIDTH, MAP_HEIGHT);
   map->Init(true);
   map_panel.Update(0, 0, width-SIDEBAR_WIDTH, height);
+  fov->Reset();
+  drift_preview->Invalidate();
+  route_planner->Reset(map, MAP_WIDTH - NEXT_LEVEL_POINT);
+  planned_turn = -1;
+  world_version++;
+  overview->Build(*map);
   Position player_start = map->GetPlayerStart();
   camera = new Position(player_start.x, player_start.y);
   
   // Create player
-  player = new Actor(player_start.x, player_start.y, (int)'@', Color(240,240,240), 1);
-  player->words = new Words("you","You","your corpse","your","sling","robes");
-  player->ai = new PlayerAi();
-  player->destructible=new PlayerDestructible(20,3);
-  player->attacker = new Attacker(15,16,3,12);
-  engine.actors.push_back(player);
+  player = game_pool->New<Actor>(player_start.x, player_start.y, (int)'@', Color(240,240,240), 1);
+  player->words = game_pool->New<Words>("you","You","your corpse","your","sling","robes");
+  player->ai = game_pool->New<PlayerAi>();
+  player->destructible = game_pool->New<PlayerDestructible>(20);
+  player->attacker = game_pool->New<Attacker>();
+  player->stats = game_pool->New<Stats>(Stats{3, 15, 16, 3, 12});
+  AddActor(player, Actor::PLAYER);
   
   // Create raft
-  raft = new Actor(player_start.x, player_start.y-2, (int)'#', Color(129,76,42), 1);
-  raft->words = new Words("raft","Raft","pile of logs"," "," ","thick wood");
-  raft->destructible = new RaftDestructible(15,9);
+  raft = game_pool->New<Actor>(player_start.x, player_start.y-2, (int)'#', Color(129,76,42), 1);
+  raft->words = game_pool->New<Words>("raft","Raft","pile of logs"," "," ","thick wood");
+  raft->destructible = game_pool->New<RaftDestructible>(15);
+  raft->stats = game_pool->New<Stats>(Stats{9, 0, 0, 0, 0});
   raft->blocks = false;
-  engine.actors.push_front(raft);
+  AddActor(raft, Actor::RAFT);
   
-  Actor* charon = new Actor(player_start.x-4, player_start.y-1, (int)'@', Color(240,230,140),1);
-  charon->words = new Words("Charon","Charon"," "," "," "," ");
-  engine.actors.push_back(charon);
-  Actor* boatl = new Actor(player_start.x-5, player_start.y-1, (int)'{', Color(129,76,42),1);
-  boatl->words = new Words("Charon's boat","Charon's boat"," "," "," "," ");
-  engine.actors.push_back(boatl);
-  Actor* boatr = new Actor(player_start.x-3, player_start.y-1, (int)'}', Color(129,76,42),1);
-  boatr->words = new Words("Charon's boat","Charon's boat"," "," "," "," ");
-  engine.actors.push_back(boatr);
-  Actor* hermes = new Actor(player_start.x-2, player_start.y+2, (int)'@', Color(240,230,140),1);
-  hermes->words = new Words("Hermes","Hermes"," "," "," "," ");
-  engine.actors.push_back(hermes);
+  Actor* charon = level_pool->New<Actor>(player_start.x-4, player_start.y-1, (int)'@', Color(240,230,140),1);
+  charon->words = level_pool->New<Words>("Charon","Charon"," "," "," "," ");
+  AddActor(charon, Actor::CREATURES);
+  Actor* boatl = level_pool->New<Actor>(player_start.x-5, player_start.y-1, (int)'{', Color(129,76,42),1);
+  boatl->words = level_pool->New<Words>("Charon's boat","Charon's boat"," "," "," "," ");
+  AddActor(boatl, Actor::CREATURES);
+  Actor* boatr = level_pool->New<Actor>(player_start.x-3, player_start.y-1, (int)'}', Color(129,76,42),1);
+  boatr->words = level_pool->New<Words>("Charon's boat","Charon's boat"," "," "," "," ");
+  AddActor(boatr, Actor::CREATURES);
+  Actor* hermes = level_pool->New<Actor>(player_start.x-2, player_start.y+2, (int)'@', Color(240,230,140),1);
+  hermes->words = level_pool->New<Words>("Hermes","Hermes"," "," "," "," ");
+  AddActor(hermes, Actor::CREATURES);
   
   engine.Update();
   engine.Render();
@@ -104,7 +140,9 @@ void Engine::Init() {
 };
 
 void Engine::Term() {
-    actors.clear();
+    ClearActors();
+    ReleaseLevel();
+    game_pool->Release();
     if (map) delete map;
     if (camera) delete camera;
     gui->Clear();
@@ -115,6 +153,11 @@ void Engine::ProcessInput() {
     int key = terminal_read();
     bool shift = terminal_check(TK_SHIFT);
     gui->ProcessInput(key);
+    // Shift and the arrow keys look around the zoomed-out view.
+    if (overview->zoom > 0 && shift && overview->Pan(key, map_panel)) {
+      UpdateMouse();
+      continue;
+    }
     if (key == TK_CLOSE) {
       status = CLOSED;
     } else if (key == TK_ESCAPE && game_status != AIMING) {
@@ -133,10 +176,17 @@ void Engine::ProcessInput() {
 	    }
     } else if (key == TK_MOUSE_MOVE) {
       UpdateMouse(); // This is actually redundant.
+    } else if (key == TK_D && !shift) {
+      drift_preview->enabled = !drift_preview->enabled;
+    } else if (key == TK_R && !shift) {
+      show_route = !show_route;
+    } else if (key == TK_Z && !shift) {
+      overview->ZoomOut();
+      UpdateMouse();
     }
     if (game_status == AIMING) {
       int x, y;
-      engine.PickATile(key, &x, &y, player->attacker->max_range);
+      engine.PickATile(key, &x, &y, player->stats->max_range);
     } else if (game_status == IDLE || game_status == STARTUP) {
       player->ProcessInput(key, shift);
     }
@@ -144,13 +194,43 @@ void Engine::ProcessInput() {
 };
 
 void Engine::UpdateMouse() {
-  mouse->x = terminal_state(TK_MOUSE_X)/2 + camera->x - map_panel.width/4;
-  mouse->y = -terminal_state(TK_MOUSE_Y) + camera->y + map_panel.height/2;
+  // Each cell covers more tiles when zoomed out.
+  Position center = overview->GetCenter(*camera);
+  int scale = 1 << overview->zoom;
+  mouse->x = (terminal_state(TK_MOUSE_X)/2 - map_panel.width/4)*scale + center.x;
+  mouse->y = (-terminal_state(TK_MOUSE_Y) + map_panel.height/2)*scale + center.y;
 };
 
 void Engine::Render() {
-  terminal_clear();
+  // The sidebar keeps what it drew last frame, so only the map is cleared
+  // unless something has drawn over the sidebar.
+  terminal_bkcolor("black");
+  if (gui->NeedsClear()) {
+    terminal_clear();
+  } else {
+    for (int layer : {MAP, ACTORS, OVERLAY}) {
+      terminal_layer(layer);
+      terminal_clear_area(0, 0, map_panel.width-1, map_panel.height);
+    }
+  }
   
+  if (overview->zoom > 0) {
+    overview->Render(map_panel, *camera);
+  } else {
+    RenderMap();
+  }
+  
+  // Gui
+  gui->Render();
+
+  // Print out results
+  terminal_refresh();
+
+};
+
+/** Draws the map and everything on it at full size.
+ */
+void Engine::RenderMap() {
   // Map
   terminal_layer(MAP);
   map->Render(map_panel, camera);
@@ -158,29 +238,53 @@ void Engine::Render() {
   
   // Actors
   terminal_layer(ACTORS);
-  for (Actor* actor : actors) {
-    RenderActor(actor);
-  };
+  map->RenderDecals(map_panel, camera);
+  RenderActors();
   terminal_crop(0,0,map_panel.width-1, map_panel.height);
   
-  // Gui
-  gui->Render();
-
-  // Print out results
-  terminal_refresh();
-
+  // Projected raft paths
+  if (drift_preview->enabled && OnRaft()) {
+    terminal_layer(OVERLAY);
+    drift_preview->Update(*map, player->x, player->y);
+    drift_preview->Render(map_panel, camera);
+    terminal_crop(0,0,map_panel.width-1, map_panel.height);
+  }
+  if (show_route && OnRaft()) {
+    terminal_layer(OVERLAY);
+    RenderRoute();
+    terminal_crop(0,0,map_panel.width-1, map_panel.height);
+  }
 };
 
-void Engine::RenderActor(Actor* actor) {
-  int term_x = (actor->x - camera->x)*2 + map_panel.width/2;
-  int term_y = -actor->y + camera->y + map_panel.height/2;
-  if (term_x < map_panel.width-1 && term_y < map_panel.height) {
-      terminal_color(actor->color.Convert());
-      terminal_bkcolor(terminal_pick_color(term_x, term_y, 0));
-      terminal_printf(term_x, term_y, "[font=tile]%c", (char*)actor->symbol);
-      terminal_color(color_from_name("white"));
-      terminal_bkcolor(color_from_name("black"));
-  };
+/** Draws the actors that are on screen.
+ *
+ * Only the tiles in view are looked at, so the cost depends on how many
+ * actors can be seen, not on how many are on the level.  Positions and
+ * glyphs come from the store's arrays, so no Actor is touched.  The colour
+ * is only changed when it differs from the last actor's.
+ */
+void Engine::RenderActors() {
+  int x0 = camera->x - map_panel.width/4;
+  int y0 = camera->y + map_panel.height/2 - (map_panel.height-1);
+  actor_grid->Update(*actor_store, world_version);
+  actor_grid->GetEntitiesIn(x0, y0, x0 + map_panel.width/2 + 1,
+                            camera->y + map_panel.height/2 + 1,
+                            visible_entities);
+  color_t current = color_from_name("white");
+  terminal_color(current);
+  for (int entity : visible_entities) {
+    int term_x = (actor_store->x[entity] - camera->x)*2 + map_panel.width/2;
+    int term_y = -actor_store->y[entity] + camera->y + map_panel.height/2;
+    if (term_x < 0 || term_y < 0 ||
+        term_x >= map_panel.width-1 || term_y >= map_panel.height) continue;
+    color_t color = actor_store->color[entity];
+    if (color != current) {
+      terminal_color(color);
+      current = color;
+    }
+    terminal_put(term_x, term_y, TILE_CODE + actor_store->symbol[entity]);
+  }
+  terminal_color(color_from_name("white"));
 };
 
 void Engine::Update() {
@@ -190,11 +294,29 @@ void Engine::Update() {
   if (game_status == NEW_TURN || game_status == STARTUP || 
       game_status == IDLE     || game_status == AIMING) {
     player->Update();
+    fov->Update(*map, player->x, player->y);
     if (game_status == NEW_TURN) {
       UpdateMouse(); // Map may have moved...
-      for (Actor* actor : actors) {
-          if (actor != player) actor->Update();
+      threat_pass->Update(*actor_store, player);
+      // Monsters far from the player are skipped using the store's arrays,
+      // without touching the Actor.  Once one is near, it stays active.
+      // The monsters all have the same Ai, so it's called directly rather
+      // than through the vtable.  Going by index keeps this safe if one of
+      // them is removed along the way.
+      ActorStore& store = *actor_store;
+      for (int i=0; i<store.ai.Size(); i++) {
+        int monster = store.ai[i];
+        if (store.hp[monster] <= 0) continue;
+        if (!(store.flags[monster] & ActorStore::ACTIVE)) {
+          if (std::abs(store.x[monster] - player->x) >= 60) continue;
+          store.flags[monster] |= ActorStore::ACTIVE;
+        }
+        Actor* actor = store.actors[monster];
+        static_cast<MonsterAi*>(actor->ai)->Update(actor);
       }
+      combat_log->EndTurn();
+      turn++;
+      world_version++;
     }
   }
   // Update the map
@@ -237,14 +359,63 @@ bool Engine::CursorOnMap() {
     return false;
 };
 
+/** Checks to see if the player is standing on the raft.
+ */
+bool Engine::OnRaft() const {
+  return (player->x == raft->x && player->y == raft->y);
+};
+
+/** Finds the best route for the raft to the end of the level.
+ *
+ * The route is only planned once per turn.  It can be drawn as a hint, and
+ * its first move is available from the route planner.
+ *
+ * @return True if there is a route from the player's position.
+ */
+bool Engine::PlanRoute() {
+  if (planned_turn == turn && planned_from.x == player->x &&
+      planned_from.y == player->y) {
+    return !route_planner->GetRoute().empty();
+  }
+  planned_turn = turn;
+  planned_from = Position(player->x, player->y);
+
+  std::vector<Threat> threats;
+  const ActorStore& store = *actor_store;
+  for (int i=0; i<store.ai.Size(); i++) {
+    int monster = store.ai[i];
+    if (store.max_range[monster] > 1 && store.hp[monster] > 0) {
+      threats.push_back(Threat(store.x[monster], store.y[monster],
+                               std::min<int>(70, store.max_range[monster])));
+    }
+  }
+  return route_planner->Plan(player->x, player->y, threats);
+};
+
+void Engine::RenderRoute() {
+  if (!PlanRoute()) return;
+  terminal_color(color_from_argb(255, 120, 230, 120));
+  for (const Position& position : route_planner->GetRoute()) {
+    int term_x = (position.x - camera->x)*2 + map_panel.width/2;
+    int term_y = -position.y + camera->y + map_panel.height/2;
+    if (term_x < 0 || term_y < 0 ||
+        term_x >= map_panel.width-1 || term_y >= map_panel.height) continue;
+    terminal_put(term_x, term_y, TILE_CODE + '+');
+  }
+  terminal_color(color_from_name("white"));
+};
+
 bool Engine::PickATile(int key, int *x, int *y, int max_range) {
   if (key == TK_MOUSE_LEFT && CursorOnMap()) {
     float distance = player->GetDistance(mouse->x, mouse->y);
-    if (distance < max_range) {
-      for (Actor* actor : actors) {
+    if (distance < max_range && !fov->isVisible(mouse->x, mouse->y)) {
+      engine.gui->log->Print("[color=yellow]Something blocks your line of fire.");
+    } else if (distance < max_range) {
+      std::vector<Actor*> found;
+      GetActorsAt(mouse->x, mouse->y, found);
+      for (Actor* actor : found) {
         if (actor == player) continue;
-        if (actor->x == mouse->x && actor->y == mouse->y &&
-            actor->destructible && !actor->destructible->isDead()) {
+        if (actor->destructible && !actor->destructible->isDead()) {
           player->attacker->SetAim(actor);
           return true;
         }; 
@@ -308,20 +479,128 @@ void Engine::NextLevel() {
     delete map;
     
     // delete all actors but the player and the raft
-    for (unsigned int i=0; i<actors.size(); i++) {
-      if (actors[i] != player && actors[i] != raft) {
-        actors.erase(actors.begin()+i);
-        i--;
-      };
-    };
+    ClearActors();
+    ReleaseLevel();
+    AddActor(raft, raft->render_layer);
+    AddActor(player, player->render_layer);
     
     // create a new map
     map = new Map(MAP_WIDTH, MAP_HEIGHT);
     map->Init(true);
     map_panel.Update(0, 0, width-SIDEBAR_WIDTH, height);
+    fov->Reset();
+    drift_preview->Invalidate();
+    route_planner->Reset(map, MAP_WIDTH - NEXT_LEVEL_POINT);
+    planned_turn = -1;
+    world_version++;
+    overview->Build(*map);
     Position player_start = map->GetPlayerStart();
-    player->x = player_start.x; player->y = player_start.y-1;
-    raft->x = player_start.x; raft->y = player_start.y - 2;
+    MoveActor(player, player_start.x, player_start.y-1);
+    MoveActor(raft, player_start.x, player_start.y-2);
     camera->x = player_start.x; camera->y = player_start.y-1;
   }
 };
+
+/** Adds an actor to the level.
+ *
+ * @param actor - The new actor
+ * @param layer - Where the actor is drawn, relative to the others
+ */
+void Engine::AddActor(Actor* actor, Actor::RenderLayer layer) {
+  actor->render_layer = layer;
+  // Only actors that can shoot have an attack and a range in the store.
+  Stats stats = {};
+  if (actor->attacker || actor->destructible) stats = actor->GetStats();
+  if (!actor->attacker) stats.attack = stats.max_range = 0;
+  actor->entity = actor_store->Add(actor, stats);
+  world_version++;
+};
+
+/** Removes an actor from the level.
+ *
+ * The last actor takes its entity, so this doesn't depend on the number of
+ * actors.  The actor itself is owned by a pool, so it stays valid until the
+ * level changes.
+ */
+void Engine::RemoveActor(Actor* actor) {
+  actor_store->Remove(actor->entity);
+  actor->entity = -1;
+  world_version++;
+};
+
+/** Moves an actor, keeping its entity and the blocked tiles up to date.
+ *
+ * Anything on the level has to be moved through here, rather than by
+ * changing its position directly.
+ */
+void Engine::MoveActor(Actor* actor, int x, int y) {
+  if (actor->entity >= 0) actor_store->Move(actor->entity, x, y);
+  actor->x = x;
+  actor->y = y;
+  world_version++;
+};
+
+/** Changes whether an actor blocks its tile, e.g. when it dies.
+ */
+void Engine::SetBlocks(Actor* actor, bool blocks) {
+  if (actor->blocks == blocks) return;
+  if (actor->entity >= 0) actor_store->SetBlocks(actor->entity, blocks);
+  actor->blocks = blocks;
+};
+
+/** Destroys everything that was on the level, all at once.
+ *
+ * The actors have to be taken off the level first.
+ */
+void Engine::ReleaseLevel() {
+  // The combat log may still have attacks by or on them to write.
+  combat_log->EndTurn();
+  level_pool->Release();
+};
+
+/** Moves an actor to another render layer, e.g. when it dies.
+ *
+ * Its symbol and colour are copied to the store again, so change those
+ * first.
+ */
+void Engine::SetRenderLayer(Actor* actor, Actor::RenderLayer layer) {
+  if (actor->render_layer == layer) return;
+  actor->render_layer = layer;
+  if (actor->entity >= 0) actor_store->SetLayer(actor->entity, layer);
+  world_version++;
+};
+
+/** Removes every actor from the level, without deleting them.
+ */
+void Engine::ClearActors() {
+  actor_store->Clear();
+  world_version++;
+};
+
+/** Lists the actors on a tile, in the order they are drawn.
+ *
+ * @param x - The x coordinate of the tile
+ * @param y - The y coordinate of the tile
+ * @param found - Cleared, then filled with the actors on the tile
+ */
+void Engine::GetActorsAt(int x, int y, std::vector<Actor*>& found) {
+  actor_grid->Update(*actor_store, world_version);
+  actor_grid->GetActors(x, y, found);
+};
+
+/** Lists the actors in a rectangle of tiles.
+ *
+ * The actors on each tile are in the order they are drawn, so the last one
+ * drawn on a tile is the one on top.
+ *
+ * @param x0 - The left edge of the rectangle
+ * @param y0 - The bottom edge of the rectangle
+ * @param x1 - One past the right edge
+ * @param y1 - One past the top edge
+ * @param found - Cleared, then filled with the actors in the rectangle
+ */
+void Engine::GetActorsIn(int x0, int y0, int x1, int y1,
+                         std::vector<Actor*>& found) {
+  actor_grid->Update(*actor_store, world_version);
+  actor_grid->GetActorsIn(x0, y0, x1, y1, found);
+};
@@ -0,0 +1,161 @@
+/**
+ *  \brief
+ *
+ *  Copyright (C) 2017  Chaos-Dev
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Fov.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "Map.h"
+
+// Multipliers that map the first octant onto each of the eight octants.
+static const int octants[8][4] = {
+  { 1,  0,  0,  1}, { 0,  1,  1,  0}, { 0, -1,  1,  0}, {-1,  0,  0,  1},
+  {-1,  0,  0, -1}, { 0, -1, -1,  0}, { 0,  1, -1,  0}, { 1,  0,  0, -1}
+};
+
+/** Creates an empty field of view.
+ *
+ * @param radius - The furthest distance, in tiles, that can be seen.  This
+ *   also bounds the line-of-fire queries.
+ */
+Fov::Fov(int radius)
+    : radius(radius), size(2*radius+1), words_per_row((2*radius+1+63)/64),
+      origin_x(0), origin_y(0), dirty(true) {
+  visible.resize(size*words_per_row, 0);
+};
+
+/** Forces a recalculation on the next update, e.g. after a level change.
+ */
+void Fov::Reset() {
+  dirty = true;
+};
+
+/** Recalculates the field of view if the player has moved.
+ *
+ * This is called every frame, but only does work once per move, so the
+ * monsters can query it freely during their turns.
+ *
+ * @param map - The current level.
+ * @param x - The x coordinate of the viewer
+ * @param y - The y coordinate of the viewer
+ */
+void Fov::Update(const Map& map, int x, int y) {
+  if (!dirty && x == origin_x && y == origin_y) return;
+  origin_x = x; origin_y = y;
+  dirty = false;
+
+  std::fill(visible.begin(), visible.end(), 0);
+  SetVisible(x, y);
+  for (int i=0; i<8; i++) {
+    CastLight(map, 1, 1.0, 0.0, octants[i][0], octants[i][1],
+              octants[i][2], octants[i][3]);
+  }
+};
+
+/** Scans one octant row by row, recursing around anything opaque.
+ *
+ * This is the standard recursive shadowcasting algorithm.  The slopes
+ * bound the part of the octant that is still lit.
+ */
+void Fov::CastLight(const Map& map, int row, float start, float end,
+                    int xx, int xy, int yx, int yy) {
+  if (start < end) return;
+  float new_start = 0.0;
+  for (int j=row; j<=radius; j++) {
+    bool blocked = false;
+    int dy = -j;
+    for (int dx=-j; dx<=0; dx++) {
+      float l_slope = (dx-0.5)/(dy+0.5);
+      float r_slope = (dx+0.5)/(dy-0.5);
+      if (start < r_slope) continue;
+      if (end > l_slope) break;
+
+      int x = origin_x + dx*xx + dy*xy;
+      int y = origin_y + dx*yx + dy*yy;
+      if (dx*dx + dy*dy <= radius*radius) SetVisible(x, y);
+
+      bool opaque = map.isOpaque(x, y);
+      if (blocked) {
+        if (opaque) {
+          new_start = r_slope;
+        } else {
+          blocked = false;
+          start = new_start;
+        }
+      } else if (opaque && j < radius) {
+        blocked = true;
+        CastLight(map, j+1, start, l_slope, xx, xy, yx, yy);
+        new_start = r_slope;
+      }
+    }
+    if (blocked) break;
+  }
+};
+
+void Fov::SetVisible(int x, int y) {
+  int i = x - origin_x + radius;
+  int j = y - origin_y + radius;
+  if (i < 0 || j < 0 || i >= size || j >= size) return;
+  visible[j*words_per_row + i/64] |= uint64_t(1) << (i%64);
+};
+
+/** Checks to see if a cell can be seen from the player's position.
+ *
+ * @param x - The x coordinate of the cell
+ * @param y - The y coordinate of the cell
+ * @return True if nothing blocks the view of the cell
+ */
+bool Fov::isVisible(int x, int y) const {
+  int i = x - origin_x + radius;
+  int j = y - origin_y + radius;
+  if (i < 0 || j < 0 || i >= size || j >= size) return false;
+  return (visible[j*words_per_row + i/64] >> (i%64)) & 1;
+};
+
+/** Checks to see if a shot can travel between two cells.
+ *
+ * When either end is the player, this is a single lookup in the visibility
+ * mask.  Otherwise the line is traced through the map.
+ *
+ * @return True if no rocks or walls are in the way.
+ */
+bool Fov::LineOfFire(const Map& map, int x0, int y0, int x1, int y1) const {
+  if (!dirty) {
+    if (x1 == origin_x && y1 == origin_y) return isVisible(x0, y0);
+    if (x0 == origin_x && y0 == origin_y) return isVisible(x1, y1);
+  }
+  return TraceLine(map, x0, y0, x1, y1);
+};
+
+/** Walks a Bresenham line between two cells, excluding the end points.
+ */
+bool Fov::TraceLine(const Map& map, int x0, int y0, int x1, int y1) const {
+  if (x0 == x1 && y0 == y1) return true;
+  int dx = std::abs(x1 - x0), sx = (x0 < x1 ? 1 : -1);
+  int dy = -std::abs(y1 - y0), sy = (y0 < y1 ? 1 : -1);
+  int err = dx + dy;
+  while (true) {
+    int e2 = 2*err;
+    if (e2 >= dy) { err += dy; x0 += sx; }
+    if (e2 <= dx) { err += dx; y0 += sy; }
+    if (x0 == x1 && y0 == y1) return true;
+    if (map.isOpaque(x0, y0)) return false;
+  }
+};
@@ -23,48 +23,186 @@
 #include <iostream>
 #include <string.h>
 
+#include "Content.h"
 #include "Engine.h"
 #include "BearLibTerminal.h"
 
 Log::Log(int sidebar_width) : sidebar_width(sidebar_width), duplicate_count(1) {
+  messages.resize(max_messages);
+  arena.resize(initial_arena_size);
   Clear();
-  const std::string prompt =
-      "----------------------------------";
-  messages.push_back(Message(prompt));
+  Print(std::string("----------------------------------"));
   UpdateGeometry();
 };
 
+/** Adds a formatted message to the log.
+ *
+ * The text is formatted straight into the end of the text arena, so printing
+ * doesn't allocate once the arena is large enough.  If the message repeats
+ * the previous one, the previous one is replaced with a count instead.
+ */
 void Log::Print(const char* message, ...) {
+  // Any attacks this turn happened before this message.
+  if (engine.combat_log) engine.combat_log->Flush();
+
   // build the text
-  va_list ap;
-  char buf[128];
+  va_list ap, aq;
   va_start(ap,message);
-  vsprintf(buf,message,ap);
+  va_copy(aq,ap);
+  int length = vsnprintf(arena.data()+arena_end, arena.size()-arena_end, message, ap);
   va_end(ap);
+  if (length < 0) {
+    va_end(aq);
+    return;
+  }
+  if (arena_end + length + max_suffix_length >= arena.size()) {
+    ReserveText(length + max_suffix_length);
+    vsnprintf(arena.data()+arena_end, arena.size()-arena_end, message, aq);
+  }
+  va_end(aq);
   
-  std::string str(buf);
-  
-  if (messages.size() > 0) {
+  AddPrinted(length);
+}
+
+void Log::Print(const std::string& message) {
+  if (engine.combat_log) engine.combat_log->Flush();
+  ReserveText(message.size() + max_suffix_length);
+  memcpy(arena.data()+arena_end, message.c_str(), message.size()+1);
+  AddPrinted(message.size());
+}
+
+/** Adds the text just printed at the end of the arena as a message.
+ *
+ * If it repeats the previous message, the previous one is removed and the
+ * text is moved back into its place with a repeat count, so a long run of
+ * the same message takes no more room than one.
+ *
+ * @param length - The length of the text, which must be followed by a null
+ *   and room for the repeat count.
+ */
+void Log::AddPrinted(size_t length) {
+  size_t start = arena_end;
+  uint32_t hash = Hash(arena.data()+start, length);
+  size_t total_length = length;
+  if (num_messages > 0) {
     // Compare this message to the last one
-    const std::string last_msg = messages.back().text;
-    if (str.compare(0,str.size(),last_msg,0,str.size()) == 0) {
+    const Message& last_msg = GetMessage(num_messages-1);
+    if (last_msg.hash == hash && last_msg.base_length == length &&
+        memcmp(GetText(last_msg), arena.data()+start, length) == 0) {
       duplicate_count++;
-      messages.pop_back();
-      str += " [[x" + std::to_string(duplicate_count) + "]]";
+      RemoveLastMessage();
+      memmove(arena.data()+arena_end, arena.data()+start, length);
+      total_length += snprintf(arena.data()+arena_end+length, max_suffix_length,
+                               " [[x%d]]", duplicate_count);
     } else {
       duplicate_count = 1;
     }
   }
-  
-  messages.push_back(Message(str));
-  UpdateHeights();
+
+  AddMessage(total_length, hash, length);
   UpdateGeometry();
 }
 
-void Log::Print(const std::string& message) {
-  messages.push_back(Message(message));
-  UpdateHeights();
-  UpdateGeometry();
+/** Finds a message by its position in the log, where 0 is the oldest.
+ */
+Message& Log::GetMessage(int index) {
+  return messages[(first_message + index) % max_messages];
+}
+
+const char* Log::GetText(const Message& message) const {
+  return &arena[message.offset];
+}
+
+/** Adds the text at the end of the arena to the log as a new message.
+ *
+ * Only the new message is measured.  If the log is full, the oldest message
+ * is dropped to make room.
+ *
+ * @param length - The length of the text, which must already be in the
+ *   arena, followed by a null.
+ * @param hash - The hash of the text without any repeat count
+ * @param base_length - The length of the text without any repeat count
+ */
+void Log::AddMessage(size_t length, uint32_t hash, size_t base_length) {
+  if (num_messages == max_messages) {
+    SpillMessage(GetMessage(0));
+    first_message = (first_message + 1) % max_messages;
+    num_messages--;
+  }
+  Message& message = GetMessage(num_messages);
+  num_messages++;
+  message.offset = arena_end;
+  message.length = length;
+  message.hash = hash;
+  message.base_length = base_length;
+  message.top = next_top;
+  arena_end += length + 1;
+  Measure(message);
+  next_top = message.top + message.height + line_padding;
+  version++;
+}
+
+/** Removes the newest message, and gives its text's room back to the arena.
+ */
+void Log::RemoveLastMessage() {
+  num_messages--;
+  next_top = GetMessage(num_messages).top;
+  arena_end = GetMessage(num_messages).offset;
+  version++;
+}
+
+/** Makes room for more text at the end of the arena.
+ *
+ * The text of messages that are no longer in the log is dropped first, by
+ * moving the remaining text to the start of the arena.  The arena only grows
+ * if that isn't enough, so in the long run it stops allocating.
+ *
+ * @param length - The length of the text to make room for, not counting the
+ *   terminating null
+ */
+void Log::ReserveText(size_t length) {
+  if (arena_end + length + 1 <= arena.size()) return;
+  size_t start = (num_messages > 0) ? GetMessage(0).offset : arena_end;
+  if (start > 0) {
+    memmove(arena.data(), arena.data()+start, arena_end - start);
+    for (int i=0; i<num_messages; i++) GetMessage(i).offset -= start;
+    arena_end -= start;
+  }
+  if (arena_end + length + 1 > arena.size())
+    arena.resize(std::max(2*arena.size(), arena_end + length + 1));
+}
+
+/** Hashes some text, for comparing a message to the previous one (FNV-1a).
+ */
+uint32_t Log::Hash(const char* text, size_t length) {
+  uint32_t hash = 2166136261u;
+  for (size_t i=0; i<length; i++) {
+    hash ^= (unsigned char)text[i];
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+/** Writes a message that is about to be dropped to the history file, if any.
+ */
+void Log::SpillMessage(const Message& message) {
+  if (history_file.empty()) return;
+  if (!history.is_open()) history.open(history_file, std::ios::app);
+  history << GetText(message) << '\n';
+}
+
+/** Keeps the messages dropped from a full log in a file.
+ *
+ * @param filename - The file to append to, or an empty string to discard
+ *   old messages instead.
+ */
+void Log::SetHistoryFile(const std::string& filename) {
+  if (history.is_open()) history.close();
+  history_file = filename;
+}
+
+void Log::Measure(Message& message) {
+  message.height = terminal_measure_ext(frame_width, 0, GetText(message)).height;
 }
 
 void Log::ProcessInput(int key) {
@@ -97,7 +235,21 @@ void Log::ProcessInput(int key) {
 
 }
 
+/** Draws the messages and the scroll bar, if anything about them has changed.
+ */
 void Log::Render() {
+  char key[96];
+  snprintf(key, sizeof(key), "%ld %d %d %d %d %d", version, frame_offset,
+           frame_width, frame_height, sidebar_start, scrollbar_offset);
+  if (!view.Changed(key)) return;
+
+  // Remove the last drawing, including any text above or below the frame
+  terminal_layer(Engine::LOG_TEXT);
+  terminal_clear_area(sidebar_start+padding_left, 0,
+                      frame_width, terminal_state(TK_HEIGHT));
+  terminal_layer(Engine::LOG_CONTROLS);
+  terminal_clear_area(scrollbar_column, 0, 1, terminal_state(TK_HEIGHT));
+
   // Frame background
   terminal_layer(Engine::MAP);
   terminal_bkcolor("darkest gray");
@@ -106,23 +258,17 @@ void Log::Render() {
   terminal_bkcolor("none");
 
   // Find topmost visible message
-  int index = 0, first_line = 0;
-  for (; first_line < total_messages_height; index++) {
-    auto& message = messages[index];
-    if (first_line + message.height >= frame_offset) {
-      // This message is partially visible
-      break;
-    }
-    first_line += message.height + line_padding;
-  }
-  int delta = first_line - frame_offset;
+  int index = FindMessage(frame_offset);
+  int delta = 0;
+  if (index < num_messages)
+    delta = GetMessage(index).top - GetMessage(0).top - frame_offset;
 
   // Drawing messages (+crop)
   terminal_layer(Engine::LOG_TEXT);
-  for (; index < messages.size() && delta <= frame_height; index++){
-    auto& message = messages[index];
+  for (; index < num_messages && delta <= frame_height; index++){
+    auto& message = GetMessage(index);
     terminal_print_ext(sidebar_start+padding_left, padding_top+delta, 
-                       frame_width, 0, TK_ALIGN_DEFAULT, message.text.c_str());
+                       frame_width, 0, TK_ALIGN_DEFAULT, GetText(message));
     delta += message.height+line_padding;
   }
   terminal_crop(sidebar_start+padding_left, padding_top,
@@ -148,9 +294,32 @@ void Log::Render() {
 };
 
 void Log::Clear() {
-  messages.clear();
+  if (!history_file.empty()) {
+    for (int i=0; i<num_messages; i++) SpillMessage(GetMessage(i));
+  }
+  first_message = 0;
+  num_messages = 0;
+  next_top = 0;
+  arena_end = 0;
   frame_offset = 0;
   dragging_scrollbar = false;
+  version++;
+}
+
+/** Forces the log to be drawn again, e.g. after a dialog covered it.
+ */
+void Log::Invalidate() {
+  view.dirty = true;
+}
+
+/** Moves the top of the log, to make room for something above it.
+ *
+ * @param top - The first row of the log
+ */
+void Log::SetTop(int top) {
+  if (top == padding_top) return;
+  padding_top = top;
+  view.dirty = true;
 }
 
 void Log::Update() {
@@ -162,17 +331,47 @@ void Log::Update() {
       terminal_state(TK_CELL_HEIGHT);
 }
 
-int Log::UpdateHeights() {
-	int total_height = 0;
-	for (auto& message: messages) {
-		message.height = terminal_measure_ext(frame_width, 0, message.text.c_str()).height;
-		total_height += message.height;
-	}
-	
-	// Add spaces between lines
-	total_height += (messages.size()-1)*line_padding;
-
-	return total_height;
+/** Measures every message again, e.g. after the log changes width.
+ */
+void Log::UpdateHeights() {
+  next_top = 0;
+  for (int i=0; i<num_messages; i++) {
+    Message& message = GetMessage(i);
+    message.top = next_top;
+    Measure(message);
+    next_top = message.top + message.height + line_padding;
+  }
+  measured_width = frame_width;
+  version++;
+}
+
+/** Finds the height of all the messages, including the spaces between them.
+ */
+int Log::GetHeight() {
+  if (num_messages == 0) return 0;
+  return next_top - GetMessage(0).top - line_padding;
+}
+
+/** Finds the first message that is at least partially visible below a line.
+ *
+ * The message positions only ever increase, so this is a binary search.
+ *
+ * @param line - A text row, counted from the top of the oldest message
+ * @return The index of the message, or the number of messages if none is
+ */
+int Log::FindMessage(int line) {
+  long base = (num_messages > 0) ? GetMessage(0).top : 0;
+  int low = 0, high = num_messages;
+  while (low < high) {
+    int mid = (low + high)/2;
+    Message& message = GetMessage(mid);
+    if (message.top - base + message.height >= line) {
+      high = mid;
+    } else {
+      low = mid + 1;
+    }
+  }
+  return low;
 }
 
 void Log::UpdateGeometry() {
@@ -188,7 +387,8 @@ void Log::UpdateGeometry() {
   frame_height = terminal_state(TK_HEIGHT) - (padding_top + padding_bottom);
 
   // Calculate new message list height
-  total_messages_height = UpdateHeights();
+  if (frame_width != measured_width) UpdateHeights();
+  total_messages_height = GetHeight();
 
   // Scrollbar
   scrollbar_height = std::min<int>(std::ceil(frame_height * (frame_height/(float)total_messages_height)), frame_height);
@@ -210,11 +410,14 @@ void Log::ScrollToPixel(int py) {
   frame_offset = std::max(0, std::min(total_messages_height-frame_height, frame_offset));
 }
 
-Gui::Gui(int sidebar_width) : sidebar_width(sidebar_width) {
+Gui::Gui(int sidebar_width) : sidebar_width(sidebar_width), needs_clear(true) {
   log = new Log(sidebar_width);
 };
 
 void Gui::Update() {
+  engine.combat_log->Flush();
+  log->SetTop(ShowMinimap() ? minimap_top + engine.overview->GetMinimapHeight() + 1
+                            : minimap_top);
   log->Update();
 };
 
@@ -224,37 +427,58 @@ void Gui::Clear() {
 
 void Gui::ProcessInput(int key) {
   log->ProcessInput(key);
+  if (key == TK_RESIZED) Invalidate();
+}
+
+/** Forces the whole screen to be drawn again on the next frame.
+ *
+ * This must be called after anything draws over the sidebar, like a dialog
+ * or the pause menu, since the sidebar is otherwise only drawn when its
+ * contents change.
+ */
+void Gui::Invalidate() {
+  title.dirty = true;
+  help.dirty = true;
+  mouse_look.dirty = true;
+  health_bar.dirty = true;
+  raft_bar.dirty = true;
+  minimap.dirty = true;
+  log->Invalidate();
+  needs_clear = true;
+}
+
+/** Clears the area of a widget on each of the sidebar's layers.
+ */
+void Gui::ClearWidget(int x, int y, int width, int height) {
+  terminal_layer(Engine::MAP);
+  terminal_bkcolor("darkest gray");
+  terminal_clear_area(x, y, width, height);
+  terminal_bkcolor("none");
+  terminal_layer(Engine::SIDEBAR_TEXT);
+  terminal_clear_area(x, y, width, height);
+  terminal_layer(Engine::SIDEBAR_CONTROLS);
+  terminal_clear_area(x, y, width, height);
 }
 
 const char* Gui::GetTitle() {
-  switch (engine.level) {
-    case 1:
-      return "[color=dark orange]Acheron: River of Pain";
-      break;
-    case 2:
-      return "[color=dark orange]Cocytus: River of Wailing";
-    case 3:
-      return "[color=dark orange]Lethe: River of Forgetfulness";
-    case 4:
-      return "[color=dark orange]Styx: River of Hatred";
-    case 5:
-      return "[color=dark orange]Phlegethon: River of Fire";
-      break;
-    default:
-      return "ERROR: TITLE NOT FOUND";
-  };
+  return LevelData::Get(engine.level).title;
 };
 
+/** Draws any parts of the sidebar that have changed since the last frame.
+ */
 void Gui::Render() {
   int sidebar_start = terminal_state(TK_WIDTH) - sidebar_width;
-  
-  terminal_layer(Engine::MAP);
-  terminal_bkcolor("darkest gray");
-  terminal_clear_area(sidebar_start+1,1,sidebar_width-2,12);
-  terminal_layer(Engine::SIDEBAR_TEXT);
-  const char* title = GetTitle();
-  terminal_print_ext(sidebar_start+1,1, sidebar_width-4, 0, TK_ALIGN_CENTER,
-                     title);
+  char key[64];
+
+  const char* title_text = GetTitle();
+  if (title.Changed(title_text)) {
+    ClearWidget(sidebar_start+1, 1, sidebar_width-2, 2);
+    terminal_layer(Engine::SIDEBAR_TEXT);
+    terminal_color(color_from_name("dark orange"));
+    terminal_print_ext(sidebar_start+1,1, sidebar_width-4, 0, TK_ALIGN_CENTER,
+                       title_text);
+    terminal_color(color_from_name("white"));
+  }
 
   // Help tip
   RenderHelp(sidebar_start+2,3);
@@ -262,18 +486,41 @@ void Gui::Render() {
   RenderMouseLook(sidebar_start+2, 7);
   
   // health bar
-  RenderBar(sidebar_start+1, 14, sidebar_width-2, 7, "Health",
-            engine.player->destructible->hp,
-            engine.player->destructible->maxHp,Color(136,13,3),Color(106,7,3));
+  snprintf(key, sizeof(key), "%d/%d", engine.player->destructible->hp,
+           engine.player->destructible->maxHp);
+  if (health_bar.Changed(key)) {
+    ClearWidget(sidebar_start+1, 14, sidebar_width-2, 1);
+    RenderBar(sidebar_start+1, 14, sidebar_width-2, 7, "Health",
+              engine.player->destructible->hp,
+              engine.player->destructible->maxHp,Color(136,13,3),Color(106,7,3));
+  }
             
   // raft integrity
-  RenderBar(sidebar_start+1, 16, sidebar_width-2, 12, "Raft Integrity:",
-            engine.raft->destructible->hp,
-            engine.raft->destructible->maxHp,Color(129,76,42),Color(73,39,14));
+  snprintf(key, sizeof(key), "%d/%d", engine.raft->destructible->hp,
+           engine.raft->destructible->maxHp);
+  if (raft_bar.Changed(key)) {
+    ClearWidget(sidebar_start+1, 16, sidebar_width-2, 1);
+    RenderBar(sidebar_start+1, 16, sidebar_width-2, 12, "Raft Integrity:",
+              engine.raft->destructible->hp,
+              engine.raft->destructible->maxHp,Color(129,76,42),Color(73,39,14));
+  }
   
+  // minimap, redrawn when the player reaches another part of it
+  if (ShowMinimap()) {
+    snprintf(key, sizeof(key), "%d %d %d", engine.level,
+             engine.player->x >> Overview::minimap_level,
+             engine.player->y >> Overview::minimap_level);
+    if (minimap.Changed(key)) {
+      int width = engine.overview->GetMinimapWidth();
+      engine.overview->RenderMinimap(sidebar_start + (sidebar_width-width)/2,
+                                     minimap_top);
+    }
+  }
+
   log->Render();
   
   terminal_bkcolor("black");
+  needs_clear = false;
 }
 
 void Gui::RenderBar(int x, int y, int width, int offset, const char *name,
@@ -303,67 +550,91 @@ void Gui::RenderBar(int x, int y, int width, int offset, const char *name,
   terminal_bkcolor("black");
 }
 
+/** Describes the tile under the mouse cursor.
+ *
+ * This is only worked out again when the cursor moves to another tile or
+ * something in the world changes.
+ */
 void Gui::RenderMouseLook(int x, int y) {
   int sidebar_start = terminal_state(TK_WIDTH) - sidebar_width;
-  if (engine.CursorOnMap()) {
-    char buf[128]=" ";
-    bool first=true;
-    for (Actor* actor : engine.actors) {
-      if (actor->x == engine.mouse->x && actor->y == engine.mouse->y) {
-        if (first) {
-          first = false;
-        } else {
-          strcat(buf, ", ");
-        };
-        strcat(buf, actor->words->name);
-        if (actor->destructible && !actor->destructible->isDead() &&
-            actor != engine.player && actor != engine.raft)
-          RenderBar(sidebar_start+1, y+5, sidebar_width-2, 9, "Enemy Health",
-            actor->destructible->hp,
-            actor->destructible->maxHp,Color(136,13,3),Color(106,7,3));
-      };
+  bool on_map = engine.CursorOnMap();
+  char key[64];
+  snprintf(key, sizeof(key), "%d %d %d %ld", on_map, engine.mouse->x,
+           engine.mouse->y, engine.world_version);
+  if (!mouse_look.Changed(key)) return;
+
+  ClearWidget(sidebar_start+1, y, sidebar_width-2, 6);
+  if (!on_map) return;
+
+  std::string names = " ";
+  Actor* enemy = nullptr;
+  bool first=true;
+  // Corpses are drawn underneath everything else, so they go first.
+  const Decal* decal = engine.map->GetDecal(engine.mouse->x, engine.mouse->y);
+  if (decal) {
+    names += decal->name;
+    first = false;
+  }
+  engine.GetActorsAt(engine.mouse->x, engine.mouse->y, found);
+  for (Actor* actor : found) {
+    if (first) {
+      first = false;
+    } else {
+      names += ", ";
     };
-    terminal_printf(x, y, "Cursor X: %d  Y: %d", engine.mouse->x, engine.mouse->y);
-    terminal_printf(x, y+1, "Under cursor:");
-    
-    // Check the terrain
+    names += actor->GetName();
+    if (actor->destructible && !actor->destructible->isDead() &&
+        actor != engine.player && actor != engine.raft)
+      enemy = actor;
+  };
+
+  terminal_layer(Engine::SIDEBAR_TEXT);
+  terminal_printf(x, y, "Cursor X: %d  Y: %d", engine.mouse->x, engine.mouse->y);
+  terminal_printf(x, y+1, "Under cursor:");
+
+  // Check the terrain
   if (engine.map->isWater(engine.mouse->x, engine.mouse->y)) {
-      terminal_printf(x, y+2, " river with speed: [[%4.1f, %4.1f]] m/s",
-                      engine.map->GetUVelocity(engine.mouse->x, engine.mouse->y),
-                      engine.map->GetVVelocity(engine.mouse->x, engine.mouse->y));
+    terminal_printf(x, y+2, " river with speed: [[%4.1f, %4.1f]] m/s",
+                    engine.map->GetUVelocity(engine.mouse->x, engine.mouse->y),
+                    engine.map->GetVVelocity(engine.mouse->x, engine.mouse->y));
   } else if (engine.map->isBeach(engine.mouse->x, engine.mouse->y)) {
-    if (engine.level <= 2) {
-      terminal_printf(x, y+2, " sand");
-    } else {
-      terminal_printf(x, y+2, " gravel");
-    }
+    terminal_print(x, y+2, (engine.level <= 2) ? " sand" : " gravel");
   } else {
-    if (engine.level <= 2) {
-      terminal_printf(x, y+2, " grass");
-    } else {
-      terminal_printf(x, y+2, " rock");
-    }
+    terminal_print(x, y+2, (engine.level <= 2) ? " grass" : " rock");
   }
 
-// Print the actors
-terminal_print_ext(x, y+3, sidebar_width-4, 0, TK_ALIGN_DEFAULT, buf);
-
+  // Print the actors
+  terminal_print_ext(x, y+3, sidebar_width-4, 0, TK_ALIGN_DEFAULT, names.c_str());
+  if (enemy)
+    RenderBar(sidebar_start+1, y+5, sidebar_width-2, 9, "Enemy Health",
+              enemy->destructible->hp,
+              enemy->destructible->maxHp,Color(136,13,3),Color(106,7,3));
+};
 
-}
-  
+/** Checks to see if the window is tall enough for the minimap.
+ */
+bool Gui::ShowMinimap() const {
+  return terminal_state(TK_HEIGHT) >= minimap_min_height;
 };
 
 void Gui::RenderHelp(int x, int y) {
+  char range[64] = "";
+  if (engine.game_status == Engine::AIMING && engine.CursorOnMap()) {
+    snprintf(range, sizeof(range), "That space is %.0f m away.\nYour max range is %d.",
+             engine.player->GetDistance(engine.mouse->x, engine.mouse->y),
+             engine.player->stats->max_range);
+  }
+  char key[80];
+  snprintf(key, sizeof(key), "%d %s", engine.game_status, range);
+  if (!help.Changed(key)) return;
 
+  ClearWidget(x-1, y, sidebar_width-2, 4);
+  terminal_layer(Engine::SIDEBAR_TEXT);
   if (engine.game_status == Engine::AIMING) {
     terminal_color("yellow");
     terminal_print_ext(x, y, sidebar_width-4, 0, TK_ALIGN_DEFAULT, 
                        "Click any square to aim, or press spacebar to cancel.");
-    if (engine.CursorOnMap()) {
-        terminal_printf(x,y+2,"That space is %.0f m away.\nYour max range is %d.",
-                        engine.player->GetDistance(engine.mouse->x, engine.mouse->y),
-                        engine.player->attacker->max_range);
-    }
+    terminal_print(x, y+2, range);
     terminal_color("white");
   } else if (engine.game_status == Engine::DEFEAT) {
     terminal_color("yellow");
@@ -372,7 +643,7 @@ void Gui::RenderHelp(int x, int y) {
     terminal_color("white");    
   } else {
     terminal_print_ext(x, y, sidebar_width-4, 0, TK_ALIGN_DEFAULT, 
-                       "Press the arrow/numpad/vi keys to move, or press 'f' to fire.");
+                       "Press the arrow/numpad/vi keys to move, or 'f' to fire. Press 'd' to show the current, 'r' for a route, or 'z' to zoom out.");
   };
 };
 
@@ -403,6 +674,7 @@ void Gui::MessageBox(const char* message) {
   };
   // Set the terminal back
   terminal_set("input.filter={keyboard, mouse+}, precise-mouse=true");
+  Invalidate();
 
 };
 
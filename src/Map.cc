@@ -18,11 +18,16 @@
 
 #include "Map.h"
 
+#include <algorithm>
 #include <cmath>
+#include <cstdlib>
 #include <random>
 
 #include "BearLibTerminal.h"
 #include "Color.h"
+#include "PackedColor.h"
+#include "Content.h"
+#include "GridLine.h"
 #include "Actor.h"
 #include "Engine.h"
 
@@ -39,6 +44,14 @@ void Map::Init(bool withActors) {
   SetColors();
   tiles.resize(height*width);
   river = new River(width);
+  color_t water = PackedColor::Pack(water_color);
+  color_t beach = PackedColor::Pack(beach_color);
+  color_t bg = PackedColor::Pack(bg_color);
+  color_t edge = PackedColor::Pack(beach_color*0.5 + bg_color*0.5);
+  // The water is blended toward the beach colour at the banks, all at once
+  // after the loop.
+  std::vector<color_t> colors(width*height);
+  std::vector<uint16_t> weights(width*height, 0);
   for (int x=0; x<width; x++) {
     for (int y=0; y<height; y++) {
       float vel = river->GetVelocity(x,y);
@@ -46,42 +59,31 @@ void Map::Init(bool withActors) {
       tiles[x + y*width].u = vel*std::cos(river->angle[x]);
       tiles[x + y*width].v = vel*std::sin(river->angle[x]);
       if (vel > 0) {
-        tiles[x + y*width].color = water_color*(vel/(river->mean_velocity[x]*1.5)) + 
-                                   beach_color*(1.0-(vel/(river->mean_velocity[x]*1.5)));
+        colors[x + y*width] = beach;
+        weights[x + y*width] =
+            PackedColor::Weight(vel/(river->mean_velocity[x]*1.5));
       } else if (river->isBeach(x, y)) {
-        tiles[x + y*width].color = beach_color;
+        colors[x + y*width] = beach;
       } else if (river->isBeach(x,y-1) || river->isBeach(x,y+1)) {
-        tiles[x + y*width].color = beach_color*0.5 + bg_color*0.5;
+        colors[x + y*width] = edge;
       } else {
-        tiles[x + y*width].color = bg_color;
+        colors[x + y*width] = bg;
       }
     }
   }
+  PackedColor::Lerp(colors.data(), water, weights.data(), colors.data(),
+                    width*height);
+  for (int i=0; i<width*height; i++) tiles[i].color = colors[i];
   
-  // Rocks have to go first, so they're on the bottom.
+  CreateDriftTables();
+  CreateColorRuns();
+  CreateVertexColors();
+
   PlaceRocks();
   
-  // Push the raft above the rocks
-  for (int i=0; i<engine.actors.size(); i++) {
-    if (engine.actors[i] == engine.raft) {
-      engine.actors.erase(engine.actors.begin()+i);
-      engine.actors.push_back(engine.raft);
-      break;
-    };
-  }
-  
   PlaceMonsters();
   
   PlaceItems();
-
-  // Push the player back to the top.
-  for (int i=0; i<engine.actors.size(); i++) {
-      if (engine.actors[i] == engine.player) {
-      engine.actors.erase(engine.actors.begin()+i);
-      engine.actors.push_back(engine.player);
-      break;
-    };
-  }
 };
 
 void Map::PlaceMonsters() {
@@ -97,10 +99,9 @@ void Map::PlaceMonsters() {
     
     if (CanWalk(x,y)) {
         AddMonster(x,y);
-        Actor* new_monster = engine.actors.back();
+        Actor* new_monster = engine.actor_store->actors.back();
         if (isWater(x,y) && !new_monster->can_fly) {
-            engine.actors.pop_back();
-            delete new_monster;
+            engine.RemoveActor(new_monster);
         } else {
             num_enemies--;
         }
@@ -112,7 +113,7 @@ void Map::PlaceMonsters() {
     int y = (int)(dist(engine.rng)*100+200);
     
     Actor* Thanatos = CreateMonster(MonsterType::THANATOS, x, y);
-    engine.actors.push_back(Thanatos);
+    engine.AddActor(Thanatos, Actor::CREATURES);
   };
 }
 
@@ -143,7 +144,7 @@ void Map::PlaceItems() {
         AddWeapon(x,y);
         if (engine.level == 4) {
           Actor* chimera = CreateMonster(MonsterType::CHIMERA, x, y);
-          engine.actors.push_back(chimera);
+          engine.AddActor(chimera, Actor::CREATURES);
         };
         num_weapons--;
     };
@@ -161,7 +162,7 @@ void Map::PlaceItems() {
         AddArmor(x,y);
         if (engine.level == 4) {
           Actor* cerberus = CreateMonster(MonsterType::CERBERUS, x, y);
-          engine.actors.push_back(cerberus);
+          engine.AddActor(cerberus, Actor::CREATURES);
         };
         num_armor--;
     };
@@ -169,60 +170,36 @@ void Map::PlaceItems() {
 };
 
 void Map::PlaceRocks() {
+  static const Words rock_words("rock","Rock"," "," "," "," ");
+  Pool* pool = engine.level_pool;
   for (Rock rock : river->rocks) {
+    for (int i=0; i<rock.width; i++) {
+      if (inBounds(rock.x, rock.y+i)) tiles[rock.x + (rock.y+i)*width].rock = true;
+    }
     //if (rock.x == engine.raft->x && rock.y == engine.raft->y) continue;
     if (rock.width == 1) {
-      Actor* actor = new Actor(rock.x, rock.y, '*', rock_color,1);
-       actor->words = new Words("rock","Rock"," "," "," "," ");
+      Actor* actor = pool->New<Actor>(rock.x, rock.y, '*', rock_color,1);
+       actor->words = &rock_words;
        actor->blocks = false;
-      engine.actors.push_back(actor);
+      engine.AddActor(actor, Actor::PROPS);
     } else {
       Actor* actor;
       for (int i=0; i<rock.width; i++) {
-       Actor* actor = new Actor(rock.x, rock.y+i, '*', rock_color,1);
-       actor->words = new Words("rock","Rock"," "," "," "," ");
+       Actor* actor = pool->New<Actor>(rock.x, rock.y+i, '*', rock_color,1);
+       actor->words = &rock_words;
        actor->blocks = false;
-       engine.actors.push_back(actor);
+       engine.AddActor(actor, Actor::PROPS);
       };
     };
   };
 };
 
 void Map::SetColors() {
-  switch (engine.level) {
-    case 1:
-      water_color.Update(4,69,143);
-      beach_color.Update(166,157,123);
-      bg_color.Update(91,135,20);
-      rock_color.Update(91,96,87);
-      break;
-    case 2:
-      water_color.Update(23,61,64);
-      beach_color.Update(127,128,132);
-      bg_color.Update(83,108,76);
-      rock_color.Update(109,89,89);
-      break;
-    case 3:
-      water_color.Update(23,61,64);
-      beach_color.Update(117,122,100);
-      bg_color.Update(71,51,40);
-      rock_color.Update(75,66,55);
-      break;
-    case 4:
-      water_color.Update(23,61,64);
-      beach_color.Update(107,83,49);
-      bg_color.Update(50,36,23);
-      rock_color.Update(50,36,23);
-      break;
-    case 5:
-      water_color.Update(92,10,12);
-      bg_color.Update(24,12,14);
-      beach_color.Update(59,64,60);
-      rock_color.Update(24,12,14);
-      break;
-    default:
-      break;
-  }
+  const LevelData& data = LevelData::Get(engine.level);
+  water_color = data.water;
+  beach_color = data.beach;
+  bg_color = data.background;
+  rock_color = data.rock;
 };
 
 bool Map::isWall(int x, int y) const {
@@ -254,34 +231,212 @@ bool Map::inBounds(int x, int y) const {
 }
 
 bool Map::isRock(int x, int y) const {
-  for (Rock rock : river->rocks) {
-    if (rock.x == x && rock.y == y) return true;
-    if (rock.x == x && rock.y+1 == y && rock.width == 2) return true;
-  };
-  return false;
+  if (inBounds(x,y)) {
+    return tiles[x+y*width].rock;
+  } else {
+    return false;
+  }
+}
+
+/** Counts the rocks crossed when moving in a straight line between two tiles.
+ *
+ * Every tile under the line is checked, including both tiles beside a
+ * corner the line passes through, so it can't slip between two rocks on a
+ * diagonal.  See GridLine::Supercover.  Nothing is allocated, so the route
+ * planner can sweep every move on the level when it loads.
+ *
+ * @param x0 - The x coordinate of the starting tile, which is not checked
+ * @param y0 - The y coordinate of the starting tile
+ * @param x1 - The x coordinate of the final tile
+ * @param y1 - The y coordinate of the final tile
+ * @return The number of rocks that were hit
+ */
+int Map::CountRocks(int x0, int y0, int x1, int y1) const {
+  int hits = 0;
+  GridLine::Supercover(x0, y0, x1, y1, [&](int x, int y) {
+    if (isRock(x, y)) hits++;
+  });
+  return hits;
+}
+
+/** Checks to see if a tile blocks sight and projectiles.
+ *
+ * Anything off the edge of the map is treated as opaque.
+ */
+bool Map::isOpaque(int x, int y) const {
+  if (inBounds(x,y)) {
+    return tiles[x+y*width].rock || !tiles[x+y*width].canWalk;
+  } else {
+    return true;
+  }
 }
 
+/** Splits each row of the map into runs of tiles with the same colour.
+ *
+ * The colours never change during a level, so this is done once, and lets
+ * the renderer fill most of the screen with a few spans.
+ */
+void Map::CreateColorRuns() {
+  std::vector<color_t> colors(width*height);
+  std::vector<bool> water(width*height);
+  for (int x=0; x<width; x++) {
+    for (int y=0; y<height; y++) {
+      colors[x + y*width] = tiles[x + y*width].color;
+      water[x + y*width] = isWater(x, y);
+    }
+  }
+  color_runs.Build(colors, water, width, height);
+};
+
+/** Finds the shape of the circle of tiles within a weapon's range.
+ *
+ * The circle is symmetric, so it is stored as the furthest horizontal
+ * distance in range for each vertical distance from the player.  Each range
+ * is only worked out once, using integers, and matches the distances from
+ * Actor::GetDistance.
+ *
+ * @param range - The weapon's range, in tiles
+ */
+const std::vector<int>& Map::GetAimingDisc(int range) const {
+  if (range >= (int)aiming_discs.size()) aiming_discs.resize(range+1);
+  std::vector<int>& disc = aiming_discs[range];
+  if (disc.empty()) {
+    disc.resize(range+1);
+    int dx = range;
+    for (int dy=0; dy<=range; dy++) {
+      while (dx*dx + dy*dy > range*range) dx--;
+      disc[dy] = dx;
+    }
+  }
+  return disc;
+};
+
+/** Creates the colours of the water at the corners of each half tile.
+ *
+ * Each tile is drawn as two cells, so the grid has two columns of corners
+ * per tile.  The colours follow the river's velocity profile between the
+ * tiles, so the water fades smoothly into the beach.
+ */
+void Map::CreateVertexColors() {
+  int columns = 2*width + 1;
+  vertex_colors.assign(columns*(height+1), PackedColor::Pack(beach_color));
+  std::vector<uint16_t> weights(columns*(height+1));
+  for (int vy=0; vy<=height; vy++) {
+    for (int vx=0; vx<columns; vx++) {
+      float speed = river->GetRelativeVelocity((vx-1)/2.0, vy-0.5);
+      weights[vx + vy*columns] = PackedColor::Weight(speed);
+    }
+  }
+  PackedColor::Lerp(vertex_colors.data(), PackedColor::Pack(water_color),
+                    weights.data(), vertex_colors.data(), vertex_colors.size());
+};
+
+/** Draws the visible part of the map.
+ *
+ * Runs of tiles with the same colour are filled in as one span of the
+ * background, while the water is drawn a cell at a time, blending between
+ * the colours at the cell's corners.
+ */
 void Map::Render(Panel panel, Position* camera) const {
   color_t corner_colors[4];
-  Color color;
-  for (int term_x=panel.tl_corner.x; term_x < panel.br_corner.x; term_x++) {
-    for (int term_y=panel.tl_corner.y; term_y < panel.br_corner.y; term_y++) {
-      int game_x = term_x/2 + camera->x - panel.width/4;
-      int game_y = height - (term_y + height-camera->y - panel.height/2);
-      if (inBounds(game_x, game_y)) {
-        for (int corner = 0; corner<4; corner++) {
-          color = tiles[game_x + game_y*width].color;
-          if (engine.game_status == Engine::AIMING) {
-            if (engine.player->GetDistance(game_x, game_y) <= 
-                engine.player->attacker->max_range)
-              color = color*float(.9) + Color(255,255,255)*float(.1);
+  int columns = 2*width + 1;  // Corners in each row of the vertex grid
+  int x_offset = camera->x - panel.width/4; // game_x = term_x/2 + x_offset
+  bool aiming = (engine.game_status == Engine::AIMING);
+  int range = aiming ? engine.player->stats->max_range : 0;
+  int x_min = std::max(0, panel.tl_corner.x/2 + x_offset);
+  int x_max = std::min(width, (panel.br_corner.x-1)/2 + x_offset + 1);
+  for (int term_y=panel.tl_corner.y; term_y < panel.br_corner.y; term_y++) {
+    int game_y = height - (term_y + height-camera->y - panel.height/2);
+    if (game_y < 0 || game_y >= height || x_min >= x_max) continue;
+
+    // Tiles in this row within range while aiming, if there are any.
+    int aim_start = 0, aim_end = 0;
+    int dy = std::abs(game_y - engine.player->y);
+    if (aiming && dy <= range) {
+      int half_width = GetAimingDisc(range)[dy];
+      aim_start = engine.player->x - half_width;
+      aim_end = engine.player->x + half_width + 1;
+    }
+
+    // Start at the run containing the first visible tile.
+    const ColorRun* run = color_runs.Find(game_y, x_min);
+    const ColorRun* row_end = color_runs.RowEnd(game_y);
+
+    for (; run != row_end && run->start < x_max; ++run) {
+      int start = std::max(run->start, x_min);
+      int end = std::min(run->end, x_max);
+      if (run->water) {
+        for (int game_x=start; game_x<end; game_x++) {
+          bool in_range = (game_x >= aim_start && game_x < aim_end);
+          for (int i=0; i<2; i++) {
+            int term_x = (game_x - x_offset)*2 + i;
+            if (term_x < panel.tl_corner.x || term_x >= panel.br_corner.x)
+              continue;
+            // Corners go top-left, bottom-left, bottom-right, top-right.
+            const color_t* bottom = &vertex_colors[2*game_x + i + game_y*columns];
+            const color_t* top = bottom + columns;
+            corner_colors[0] = top[0];
+            corner_colors[1] = bottom[0];
+            corner_colors[2] = bottom[1];
+            corner_colors[3] = top[1];
+            if (in_range)
+              PackedColor::Mix(corner_colors, 0xFFFFFFFF, aiming_weight,
+                               corner_colors, 4);
+            terminal_put_ext(term_x, term_y, 0, 0, 0x2588, corner_colors);
           }
-          corner_colors[corner] = color.Convert();
         }
-        terminal_put_ext(term_x, term_y, 0, 0, 0x2588, corner_colors);
+        continue;
+      }
+
+      // Split the run at the edges of the range while aiming.
+      while (start < end) {
+        bool in_range = (start >= aim_start && start < aim_end);
+        int span_end = in_range ? aim_end : (start < aim_start ? aim_start : end);
+        span_end = std::min(span_end, end);
+        int term_start = std::max(panel.tl_corner.x, (start - x_offset)*2);
+        int term_end = std::min(panel.br_corner.x, (span_end - x_offset)*2);
+        color_t color = tiles[start + game_y*width].color;
+        if (in_range)
+          PackedColor::Mix(&color, 0xFFFFFFFF, aiming_weight, &color, 1);
+        terminal_bkcolor(color);
+        terminal_clear_area(term_start, term_y, term_end - term_start, 1);
+        start = span_end;
+      }
+    }
+  }
+  terminal_bkcolor("black");
+};
+
+/** Draws the corpses on the visible part of the map.
+ *
+ * Only the tiles in view are looked at, so the cost doesn't grow with the
+ * number of monsters killed.  Call this on the actor layer, before the
+ * actors, so the corpses stay underneath them.
+ */
+void Map::RenderDecals(Panel panel, Position* camera) const {
+  int x0 = std::max(0, camera->x - panel.width/4);
+  int x1 = std::min(width, camera->x + panel.width/4 + 1);
+  int y0 = std::max(0, camera->y + panel.height/2 - (panel.height-1));
+  int y1 = std::min(height, camera->y + panel.height/2 + 1);
+  color_t current = color_from_name("white");
+  terminal_color(current);
+  for (int y=y0; y<y1; y++) {
+    for (int x=x0; x<x1; x++) {
+      int index = tiles[x + y*width].decal;
+      if (index < 0) continue;
+      int term_x = (x - camera->x)*2 + panel.width/2;
+      int term_y = -y + camera->y + panel.height/2;
+      if (term_x < 0 || term_y < 0 ||
+          term_x >= panel.width-1 || term_y >= panel.height) continue;
+      const Decal& decal = decals[index];
+      if (decal.color != current) {
+        terminal_color(decal.color);
+        current = decal.color;
       }
+      terminal_put(term_x, term_y, engine.TILE_CODE + decal.symbol);
     }
   }
+  terminal_color(color_from_name("white"));
 };
 
 Position Map::GetPlayerStart() const {
@@ -291,6 +446,10 @@ Position Map::GetPlayerStart() const {
     return position;
 };
 
+color_t Map::GetColor(int x, int y) const {
+  return tiles[x + y*width].color;
+};
+
 float Map::GetUVelocity(int x, int y) const {
     if (inBounds(x,y)) {
         return tiles[x+y*width].u;
@@ -307,316 +466,159 @@ float Map::GetVVelocity(int x, int y) const{
     };
 };
 
+/** Precomputes how far the current carries something on each tile.
+ *
+ * The velocities never change during a level, so the rounding done when the
+ * player moves is done once here.  The tile reached after holding position
+ * for a turn is also stored, so that a prediction many turns ahead is just a
+ * walk through the table.
+ */
+void Map::CreateDriftTables() {
+  drift.resize(width*height);
+  drift_next.resize(width*height);
+  for (int i=0; i<width*height; i++) {
+    // I cheat a little here to give the player a favorable rounding
+    drift[i].move_u = (int8_t)std::trunc(tiles[i].u);
+    drift[i].move_v = (int8_t)std::trunc(tiles[i].v);
+    drift[i].hold_u = (int8_t)std::round(tiles[i].u);
+    drift[i].hold_v = (int8_t)std::round(tiles[i].v);
+  }
+  for (int x=0; x<width; x++) {
+    for (int y=0; y<height; y++) {
+      Position next = GetDrift(x, y, x, y);
+      if (inBounds(next.x, next.y)) {
+        drift_next[x + y*width] = next.x + next.y*width;
+      } else {
+        drift_next[x + y*width] = x + y*width;
+      }
+    }
+  }
+};
+
+/** Finds where someone ends up after trying to move to a tile this turn.
+ *
+ * The current is applied one axis at a time: the x drift is read at the
+ * starting tile, and the y drift at the tile reached after drifting in x.
+ *
+ * @param x - The current x coordinate
+ * @param y - The current y coordinate
+ * @param targetx - The x coordinate they are trying to move to
+ * @param targety - The y coordinate they are trying to move to
+ * @return The position after the current has acted
+ */
+Position Map::GetDrift(int x, int y, int targetx, int targety) const {
+  Position result(targetx, targety);
+  if (inBounds(x,y)) {
+    const Drift& d = drift[x + y*width];
+    result.x += (x == targetx ? d.hold_u : d.move_u);
+  }
+  if (inBounds(result.x,y)) {
+    const Drift& d = drift[result.x + y*width];
+    result.y += (y == targety ? d.hold_v : d.move_v);
+  }
+  return result;
+};
+
+/** Predicts where someone holding position will be after several turns.
+ *
+ * Anything carried off the edge of the map stays at the last tile on it.
+ *
+ * @param x - The current x coordinate
+ * @param y - The current y coordinate
+ * @param turns - The number of turns to look ahead
+ */
+Position Map::GetDriftDestination(int x, int y, int turns) const {
+  if (!inBounds(x,y)) return Position(x, y);
+  int index = x + y*width;
+  for (int i=0; i<turns; i++) index = drift_next[index];
+  return Position(index%width, index/width);
+};
+
 bool Map::CanWalk(int x, int y) const {
   if (isWall(x,y)) {
     // this is a wall
     return false;
   }
-  for (Actor* actor : engine.actors) {
-    if ( actor->blocks && actor->x == x && actor->y == y ) {
-      return false;
-    }
-  }
-  return true;
+  return engine.actor_store->CanWalk(x,y);
 }
 
+/** Leaves a corpse on a tile.  A newer corpse covers an older one.
+ *
+ * @param symbol - The symbol to draw
+ * @param color - The colour to draw it in
+ * @param name - What mouse-look calls it.  This isn't copied, so it has to
+ *   outlive the map.
+ */
+void Map::AddDecal(int x, int y, int symbol, Color color, const char* name) {
+  if (!inBounds(x,y)) return;
+  Decal decal(symbol, color.Convert(), name);
+  int& index = tiles[x + y*width].decal;
+  if (index < 0) {
+    index = decals.size();
+    decals.push_back(decal);
+  } else {
+    decals[index] = decal;
+  }
+};
+
+/** Finds the corpse on a tile.
+ *
+ * @return The corpse, or nullptr if there isn't one
+ */
+const Decal* Map::GetDecal(int x, int y) const {
+  if (!inBounds(x,y)) return nullptr;
+  int index = tiles[x + y*width].decal;
+  return (index < 0) ? nullptr : &decals[index];
+};
+
 void Map::AddMonster(int x, int y) {
   std::uniform_int_distribution<> dist(0,100);
   int roll = dist(engine.rng);
-  switch (engine.level) {
-    case 1:
-      if ( roll < 90 ) {
-        Actor* ghost = CreateMonster(MonsterType::GHOST, x, y);
-        engine.actors.push_back(ghost);
-      } else {
-        Actor* cyclops = CreateMonster(MonsterType::CYCLOPS, x, y);
-        engine.actors.push_back(cyclops);
-      }
-      break;
-    case 2:
-      if ( roll < 50 ) {
-        Actor* centaur = CreateMonster(MonsterType::CENTAUR, x, y);
-        engine.actors.push_back(centaur);
-      } else {
-        Actor* skeleton = CreateMonster(MonsterType::SKELETON, x, y);
-        engine.actors.push_back(skeleton);
-      }
-      break;
-    case 3:
-      if ( roll < 70 ) {
-        Actor* ghoul = CreateMonster(MonsterType::GHOUL, x, y);
-        engine.actors.push_back(ghoul);
-      } else {
-        Actor* harpy = CreateMonster(MonsterType::HARPY, x, y);
-        engine.actors.push_back(harpy);
-      }
-      break;
-    case 4:
-      if ( roll < 70 ) {
-        Actor* giant = CreateMonster(MonsterType::GIANT, x, y);
-        engine.actors.push_back(giant);
-      } else {
-        Actor* manticore = CreateMonster(MonsterType::MANTICORE, x, y);
-        engine.actors.push_back(manticore);
-      }
-      break;
-    case 5:
-      if ( roll < 30 ) {
-        Actor* giant = CreateMonster(MonsterType::DRAGON, x, y);
-        engine.actors.push_back(giant);
-      } else {
-        Actor* stymp = CreateMonster(MonsterType::STYMP, x, y);
-        engine.actors.push_back(stymp);
-      }
-      break;
-    default: 
-      break;
-  };
+  const LevelData& data = LevelData::Get(engine.level);
+  int type = (roll < data.common_chance) ? data.common_monster
+                                         : data.rare_monster;
+  Actor* monster = CreateMonster(MonsterType(type), x, y);
+  engine.AddActor(monster, Actor::CREATURES);
 };
 
 Actor* Map::CreateMonster(Map::MonsterType monster_type, int x, int y) {
   std::uniform_int_distribution<> dist(0,100);
   int roll = dist(engine.rng);
-  Actor* monster = nullptr;
-  switch (monster_type) {
-    case GHOST:
-      monster = new Actor(x,y,'g',Color(241,224,197),1);
-      switch (roll%4) {
-        case 0:
-          monster->words = new Words("the ghost","The ghost","dead ghost","his","javelin","shadowy form");
-          monster->attacker = new Attacker(9,6,6,32); 
-          break;
-        case 1:
-          monster->words = new Words("the ghost","The ghost","dead ghost","his","sling","shadowy form");
-          monster->attacker = new Attacker(9,6,3,12);
-          break;
-        case 2:
-          monster->words = new Words("the ghost","The ghost","dead ghost","his","spear","shadowy form");
-          monster->attacker = new Attacker(9,6,5,1);
-          break;
-        default:
-          monster->words = new Words("the ghost","The ghost","dead ghost","his","sword","shadowy form");
-          monster->attacker = new Attacker(9,6,5,1);
-        break;
-      }
-      if (roll%2 == 0) monster->words->possessive = "her";
-      monster->destructible = new GhostDestructible(1,0);
-      monster->ai = new MonsterAi();
-      monster->can_fly = true;
-      return monster;
-      
-    case SKELETON:
-      monster = new Actor(x,y,'s',Color(241,224,197),1);
-      monster->words = new Words("the skeleton","The skeleton","pile of bones","his","sword","bones");
-      if (roll%2 == 0) monster->words->possessive = "her";
-      monster->destructible = new MonsterDestructible(12,0);
-      monster->attacker = new Attacker(15,15,11,1);
-      monster->ai = new MonsterAi();
-      return monster;
-      
-    case GHOUL:
-      monster = new Actor(x,y,'g',Color(161,195,73),1);
-      monster->words = new Words("the ghoul","The ghoul","pile of bones","his","acidic vomit","flesh");
-      if (roll%2 == 0) monster->words->possessive = "her";
-      monster->destructible = new MonsterDestructible(19,0);
-      monster->attacker = new Attacker(20,12,6,12);
-      monster->ai = new MonsterAi();
-      return monster;
-    
-    case CENTAUR:
-      monster = new Actor(x,y,'c',Color(213,160,33),2);
-      monster->words = new Words("the centaur","The centaur","dead centaur","his","arrow","skin");
-      monster->destructible = new MonsterDestructible(16,0);
-      monster->attacker = new Attacker(15,9,5,40);
-      monster->ai = new MonsterAi();
-      return monster;
-       
-    case HARPY:
-      monster = new Actor(x,y,'h',Color(213,160,33),2);
-      monster->words = new Words("the harpy","The harpy","dead harpy","her","claws","thick skin");
-      monster->destructible = new MonsterDestructible(21,0);
-      monster->can_fly = true;
-      monster->attacker = new Attacker(14,9,12,0);
-      monster->ai = new MonsterAi();
-      return monster;
-      
-    case STYMP:
-      monster = new Actor(x,y,'v',Color(213,137,54),4);
-      monster->words = new Words("the stymphalian bird","The stymphalian bird","dead stymphalian bird","his","bronze beak","metal feathers");
-      monster->destructible = new MonsterDestructible(26,6);
-      monster->can_fly = true;
-      monster->attacker = new Attacker(15,9,15,1);
-      monster->ai = new MonsterAi();
-      return monster;
-      
-    case GIANT:
-      monster = new Actor(x,y,'G',Color(130,115,92),2); 
-      monster->words = new Words("the giant","The giant","dead giant","his","boulder","fur coat");
-      monster->destructible = new MonsterDestructible(32,2);
-      monster->attacker = new Attacker(15,3,25,12);
-      monster->ai = new MonsterAi();
-      return monster;
-    
-    case CYCLOPS:
-      monster = new Actor(x,y,'O',Color(86,54,53),1);
-      monster->words = new Words("the cyclops","The cyclops","dead cyclops","his","massive club","skin");
-      monster->destructible = new MonsterDestructible(26,0);
-      monster->attacker = new Attacker(7,3,20,1);
-      monster->ai = new MonsterAi();
-      return monster;
-      
-    case MANTICORE:
-      monster = new Actor(x,y,'M',Color(0,0,0),3);
-      monster->words = new Words("the manticore","The manticore","dead manticore","the","spines shot from his tail","thick hide");
-      monster->destructible = new MonsterDestructible(22,3);
-      monster->attacker = new Attacker(15,11,9,15);
-      monster->can_fly = true;
-      monster->ai = new MonsterAi();
-      return monster;
-    case DRAGON:
-      monster = new Actor(x,y,'D',Color(164,66,0),1);
-      monster->words = new Words("the dragon","The dragon","dead dragon","her","fiery breath","scales");
-      monster->destructible = new MonsterDestructible(30,12);
-      monster->attacker = new Attacker(20,6,18,40); 
-      monster->can_fly = true;
-      monster->ai = new MonsterAi();
-      return monster;
-    case CERBERUS:
-      monster = new Actor(x,y,'3',Color(255,255,255),2);
-      monster->words = new Words("Cerberus","Cerberus","Cerberus's corpse","his","teeth","thick hide");
-      monster->destructible = new MonsterDestructible(32,6);
-      monster->attacker = new Attacker(15,11,9,1);
-      monster->ai = new MonsterAi();
-      return monster;
-    case CHIMERA:
-      monster = new Actor(x,y,'C',Color(255,255,255),2);
-      monster->words = new Words("the chimera","The chimera","the chimera's corpse","his","fiery breath","thick hide");
-      monster->destructible = new MonsterDestructible(32,6);
-      monster->attacker = new Attacker(17,13,12,40);
-      monster->ai = new MonsterAi();
-      return monster;
-    case THANATOS:
-      monster = new Actor(x,y,'T',Color(255,255,255),3);
-      monster->words = new Words("Thanatos","Thanatos","the corpse of Thanatos","his","sword of death","impenetrable skin");
-      monster->destructible = new MonsterDestructible(100,100);
-      monster->attacker = new Attacker(30,10,100,1); 
-      monster->can_fly = true;
-      monster->ai = new MonsterAi();
+  Pool* pool = engine.level_pool;
+  int archetype = Archetype::Find(monster_type, roll);
+  const Archetype& type = Archetype::Get(archetype);
+  Actor* monster = pool->New<Actor>(x,y,type.symbol,type.color,type.speed);
+  monster->archetype = archetype;
+  monster->words = &type.words[(roll%2 == 0) ? 1 : 0];
+  monster->can_fly = type.can_fly;
+  if (type.fades) {
+    monster->destructible = pool->New<GhostDestructible>(type.hp);
+  } else {
+    monster->destructible = pool->New<MonsterDestructible>(type.hp);
   }
+  monster->attacker = pool->New<Attacker>();
+  monster->ai = pool->New<MonsterAi>();
   return monster;
 };
 
 void Map::AddArmor(int x, int y) {
-  Actor* armor = nullptr;
-  std::uniform_int_distribution<> dist(0,100);
-  int roll = dist(engine.rng);
-  switch (engine.level) {
-    case 1:
-      armor = CreateItem(ItemType::LEATHER,x,y);
-      engine.actors.push_back(armor);
-      break;
-    case 2:
-      armor = CreateItem(ItemType::BRONZE,x,y);
-      engine.actors.push_back(armor);
-      break;
-    case 3:
-      armor = CreateItem(ItemType::ADAMANT,x,y);
-      engine.actors.push_back(armor);
-      break;
-    case 4:
-      armor = CreateItem(ItemType::ACHILLES,x,y);
-      engine.actors.push_back(armor);
-      break;
-    default:
-      break;
-    };
+  int type = LevelData::Get(engine.level).armor;
+  if (type < 0) return;
+  engine.AddActor(CreateItem(ItemType(type),x,y), Actor::ITEMS);
 };
 
 void Map::AddWeapon(int x, int y) {
-  Actor* weapon;
-  std::uniform_int_distribution<> dist(0,100);
-  int roll = dist(engine.rng);
-  switch (engine.level) {
-    case 1:
-      weapon = CreateItem(ItemType::SHORTBOW,x,y);
-      engine.actors.push_back(weapon);
-      break;
-    case 2:
-      weapon = CreateItem(ItemType::JAVELIN,x,y);
-      engine.actors.push_back(weapon);
-      break;
-    case 3:
-      weapon = CreateItem(ItemType::LONGBOW,x,y);
-      engine.actors.push_back(weapon);
-      break;
-    case 4:
-      weapon = CreateItem(ItemType::ARTEMIS,x,y);
-      engine.actors.push_back(weapon);
-      break;
-    default:
-      break;
-    };
+  int type = LevelData::Get(engine.level).weapon;
+  if (type < 0) return;
+  engine.AddActor(CreateItem(ItemType(type),x,y), Actor::ITEMS);
 };
 
 Actor* Map::CreateItem(ItemType item_type, int x, int y) {
-  Actor* item = nullptr;
-  switch (item_type) {
-    case SHORTBOW:
-      item = new Actor(x,y,')',Color(141,59,114),1);
-      item->blocks = false;
-      item->words = new Words("short bow","Short bow"," ", " ", "arrow"," ");
-      item->item = new Item(8,150,0);
-      return item;
-      
-    case JAVELIN:
-      item = new Actor(x,y,'/',Color(157,203,186),1);
-      item->blocks = false;
-      item->words = new Words("set of javelins", "Set of javelins", " ", " ", "javelin"," ");
-      item->item = new Item(10,35,0);
-      return item;
-    
-    case LONGBOW:
-      item = new Actor(x,y,'}',Color(242,163,89),1);
-      item->blocks = false;
-      item->words = new Words("longbow","Longbow"," ", " ", "arrows"," ");
-      item->item = new Item(12,150,0);
-      return item;
-      
-    case ARTEMIS:
-      item = new Actor(x,y,'}',Color(83,216,251),1);
-      item->blocks = false;
-      item->words = new Words("Artemis's bow","Artemis's bow"," ", " ", "arrow"," ");
-      item->item = new Item(25,200,0);
-      return item;
-      
-    case LEATHER:
-      item = new Actor(x,y,'a',Color(220,191,133),1);
-      item->blocks = false;
-      item->words = new Words("leather armor","Leather Armor"," ", " ", " "," ");
-      item->item = new Item(0,0,3);
-      return item;
-    
-    case BRONZE:
-      item = new Actor(x,y,'a',Color(225,176,126),1);
-      item->blocks = false;
-      item->words = new Words("bronze breastplate and helmet","Bronze breatplate and helmet"," ", " ", " "," ");
-      item->item = new Item(0,0,6);
-      return item;
-      
-    case ADAMANT:
-      item = new Actor(x,y,'a',Color(61,163,93),1); 
-      item->blocks = false;
-      item->words = new Words("adamant breastplate and helmet","Adamant breatplate and helmet"," ", " ", " "," ");
-      item->item = new Item(0,0,10);
-      return item;
-      
-    case ACHILLES:
-      item = new Actor(x,y,'a',Color(102,195,255),1);
-      item->blocks = false;
-      item->words = new Words("armor of Achilles","Armor of Achilles"," ", " ", " "," ");
-      item->item = new Item(0,0,100);
-      return item;
-  }
-  return nullptr;
-
+  Pool* pool = engine.level_pool;
+  const ItemData& data = ItemData::Get(item_type);
+  Actor* item = pool->New<Actor>(x,y,data.symbol,data.color,1);
+  item->blocks = false;
+  item->words = &data.words;
+  item->item = pool->New<Item>(data.damage,data.max_range,data.armor);
+  return item;
 };
@@ -97,10 +97,12 @@ Menu::MenuItemCode Menu::pick(DisplayMode mode) {
     } else if (key == TK_DOWN) {
       selectedItem = (selectedItem + 1) % items.size(); 
     } else if (key == TK_ENTER) {
+      engine.gui->Invalidate();
       return items.at(selectedItem)->code;
     } else if (key == TK_CLOSE || key == TK_ESCAPE) {
       exit = true;
     }
   };
+  engine.gui->Invalidate();
 	return NONE;
 }
@@ -0,0 +1,266 @@
+/**
+ *  \brief
+ *
+ *  Copyright (C) 2017  Chaos-Dev
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Overview.h"
+
+#include <algorithm>
+
+#include "BearLibTerminal.h"
+#include "Engine.h"
+
+Overview::Overview() : marks_version(-1), marks_zoom(-1), zoom(0) {
+};
+
+/** Builds the mip pyramid for a new level.
+ *
+ * @param map - The new level
+ */
+void Overview::Build(const Map& map) {
+  Level& base = levels[0];
+  base.width = map.width;
+  base.height = map.height;
+  base.r.resize(map.width*map.height);
+  base.g.resize(map.width*map.height);
+  base.b.resize(map.width*map.height);
+  for (int y=0; y<map.height; y++) {
+    for (int x=0; x<map.width; x++) {
+      color_t color = map.GetColor(x, y);
+      base.r[x + y*map.width] = (color >> 16) & 0xFF;
+      base.g[x + y*map.width] = (color >> 8) & 0xFF;
+      base.b[x + y*map.width] = color & 0xFF;
+    }
+  }
+  for (int i=1; i<num_levels; i++) Downsample(levels[i-1], levels[i]);
+  marks_version = -1;
+  pan = Position(0, 0);
+};
+
+void Overview::Downsample(const Level& src, Level& dst) {
+  dst.width = (src.width+1)/2;
+  dst.height = (src.height+1)/2;
+  DownsamplePlane(src.r, src.width, src.height, dst.r, dst.width, dst.height);
+  DownsamplePlane(src.g, src.width, src.height, dst.g, dst.width, dst.height);
+  DownsamplePlane(src.b, src.width, src.height, dst.b, dst.width, dst.height);
+};
+
+/** Averages each 2x2 block of texels into one.
+ *
+ * The rows are summed first and the pairs of columns second, so both loops
+ * run over contiguous arrays and can be vectorized by the compiler.  At an
+ * odd edge, the last row or column is repeated.
+ */
+void Overview::DownsamplePlane(const std::vector<uint8_t>& src, int src_width,
+                               int src_height, std::vector<uint8_t>& dst,
+                               int dst_width, int dst_height) {
+  dst.resize(dst_width*dst_height);
+  row_sum.resize(2*dst_width);
+  for (int y=0; y<dst_height; y++) {
+    const uint8_t* a = &src[2*y*src_width];
+    const uint8_t* b = &src[std::min(2*y+1, src_height-1)*src_width];
+    uint16_t* sum = row_sum.data();
+    for (int x=0; x<src_width; x++) sum[x] = a[x] + b[x];
+    if (src_width % 2) sum[src_width] = sum[src_width-1];
+
+    uint8_t* out = &dst[y*dst_width];
+    for (int x=0; x<dst_width; x++)
+      out[x] = (sum[2*x] + sum[2*x+1] + 2) >> 2;
+  }
+};
+
+color_t Overview::GetColor(const Level& level, int x, int y) const {
+  int i = x + y*level.width;
+  return color_from_argb(255, level.r[i], level.g[i], level.b[i]);
+};
+
+/** Switches to the next zoom level, or back to the map after the last one.
+ */
+void Overview::ZoomOut() {
+  zoom = (zoom + 1) % (max_zoom + 1);
+  pan = Position(0, 0);
+};
+
+/** Moves the zoomed-out view a quarter of the screen with the arrow keys.
+ *
+ * @param key - The key that was pressed
+ * @param panel - The part of the screen the view is drawn in
+ * @return True if the key was used to pan the view
+ */
+bool Overview::Pan(int key, const Panel& panel) {
+  int dx = 0, dy = 0;
+  if (key == TK_UP) {
+    dy = 1;
+  } else if (key == TK_DOWN) {
+    dy = -1;
+  } else if (key == TK_LEFT) {
+    dx = -1;
+  } else if (key == TK_RIGHT) {
+    dx = 1;
+  } else {
+    return false;
+  }
+  pan.x += dx * ((panel.width/8) << zoom);
+  pan.y += dy * ((panel.height/4) << zoom);
+  return true;
+};
+
+/** Finds the tile at the center of the zoomed-out view.
+ */
+Position Overview::GetCenter(const Position& camera) const {
+  if (zoom == 0) return camera;
+  return Position(
+      std::max(0, std::min(levels[0].width-1, camera.x + pan.x)),
+      std::max(0, std::min(levels[0].height-1, camera.y + pan.y)));
+};
+
+/** Finds the most important actor in each texel at the current zoom.
+ *
+ * The player comes first, then the raft, monsters and items.  Anything
+ * else, like rocks and corpses, is too small to see from this far away,
+ * so only the store's ai and item sets are walked.
+ */
+void Overview::UpdateMarks() {
+  if (marks_version == engine.world_version && marks_zoom == zoom) return;
+  marks_version = engine.world_version;
+  marks_zoom = zoom;
+
+  for (int i : marked) marks[i] = nullptr;
+  marked.clear();
+  const Level& level = levels[zoom];
+  marks.resize(level.width*level.height, nullptr);
+
+  auto priority = [](const Actor* actor) {
+    if (actor == engine.player) return 4;
+    if (actor == engine.raft) return 3;
+    if (actor->destructible && !actor->destructible->isDead() &&
+        actor->attacker) return 2;
+    if (actor->item) return 1;
+    return 0;
+  };
+  const ActorStore& store = *engine.actor_store;
+  auto place = [&](int entity) {
+    if (entity < 0) return;
+    const Actor* actor = store.actors[entity];
+    int rank = priority(actor);
+    if (rank == 0) return;
+    int x = store.x[entity] >> zoom, y = store.y[entity] >> zoom;
+    if (x < 0 || x >= level.width || y < 0 || y >= level.height) return;
+    const Actor*& mark = marks[x + y*level.width];
+    if (!mark) {
+      marked.push_back(x + y*level.width);
+      mark = actor;
+    } else if (priority(mark) < rank) {
+      mark = actor;
+    }
+  };
+  place(engine.player->entity);
+  place(engine.raft->entity);
+  for (int i=0; i<store.ai.Size(); i++) place(store.ai[i]);
+  for (int i=0; i<store.item.Size(); i++) place(store.item[i]);
+};
+
+/** Draws the zoomed-out view in place of the map.
+ *
+ * Each texel takes the place of a tile, and runs of texels with the same
+ * colour are filled in as one span.
+ *
+ * @param panel - The part of the screen to draw in
+ * @param camera - The center of the view before panning
+ */
+void Overview::Render(Panel panel, const Position& camera) {
+  const Level& level = levels[zoom];
+  Position center = GetCenter(camera);
+  int cx = center.x >> zoom, cy = center.y >> zoom;
+  int x_offset = cx - panel.width/4;  // texel x = term_x/2 + x_offset
+  int x_min = std::max(0, panel.tl_corner.x/2 + x_offset);
+  int x_max = std::min(level.width, (panel.br_corner.x-1)/2 + x_offset + 1);
+
+  // Terrain
+  terminal_layer(Engine::MAP);
+  for (int term_y=panel.tl_corner.y; term_y < panel.br_corner.y; term_y++) {
+    int y = cy + panel.height/2 - term_y;
+    if (y < 0 || y >= level.height) continue;
+    int start = x_min;
+    while (start < x_max) {
+      color_t color = GetColor(level, start, y);
+      int end = start+1;
+      while (end < x_max && GetColor(level, end, y) == color) end++;
+      int term_start = std::max(panel.tl_corner.x, (start - x_offset)*2);
+      int term_end = std::min(panel.br_corner.x, (end - x_offset)*2);
+      terminal_bkcolor(color);
+      terminal_clear_area(term_start, term_y, term_end - term_start, 1);
+      start = end;
+    }
+  }
+  terminal_bkcolor("black");
+  terminal_crop(0, 0, panel.width-1, panel.height);
+
+  // Actors
+  UpdateMarks();
+  terminal_layer(Engine::ACTORS);
+  for (int i : marked) {
+    const Actor* actor = marks[i];
+    int term_x = (i % level.width - x_offset)*2;
+    int term_y = cy + panel.height/2 - i / level.width;
+    if (term_x < panel.tl_corner.x || term_x >= panel.width-1 ||
+        term_y < panel.tl_corner.y || term_y >= panel.height) continue;
+    terminal_color(actor->color.Convert());
+    terminal_put(term_x, term_y, engine.TILE_CODE + actor->symbol);
+  }
+  terminal_color("white");
+  terminal_crop(0, 0, panel.width-1, panel.height);
+};
+
+int Overview::GetMinimapWidth() const {
+  return levels[minimap_level].width;
+};
+
+int Overview::GetMinimapHeight() const {
+  return (levels[minimap_level].height+1)/2;
+};
+
+/** Draws the whole level in the sidebar, with the player in white.
+ *
+ * Each cell holds two texels, one above the other: the lower one is the
+ * background, and the upper one an upper half block.  This keeps the
+ * texels square, since the cells are twice as tall as they are wide.
+ *
+ * @param x - The left edge of the minimap
+ * @param y - The top edge of the minimap
+ */
+void Overview::RenderMinimap(int x, int y) const {
+  const Level& level = levels[minimap_level];
+  int player_x = engine.player->x >> minimap_level;
+  int player_y = engine.player->y >> minimap_level;
+  color_t white = color_from_argb(255, 255, 255, 255);
+  terminal_layer(Engine::MAP);
+  for (int row=0; row<GetMinimapHeight(); row++) {
+    int top = level.height-1 - 2*row;
+    int bottom = top-1;
+    for (int column=0; column<level.width; column++) {
+      bool top_is_player = (column == player_x && top == player_y);
+      bool bottom_is_player = (column == player_x && bottom == player_y);
+      terminal_bkcolor(bottom < 0 ? color_from_argb(255, 0, 0, 0) :
+                       bottom_is_player ? white : GetColor(level, column, bottom));
+      terminal_color(top_is_player ? white : GetColor(level, column, top));
+      terminal_put(x+column, y+row, 0x2580);
+    }
+  }
+  terminal_bkcolor("black");
+  terminal_color("white");
+};
@@ -0,0 +1,127 @@
+/**
+ *  \brief
+ *
+ *  Copyright (C) 2017  Chaos-Dev
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "PackedColor.h"
+
+#include <algorithm>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+static const color_t opaque = 0xFF000000;
+
+const int PackedColor::one;
+
+color_t PackedColor::Pack(const Color& color) {
+  return color.Convert();
+};
+
+/** Converts a fraction from 0 to 1 into a blending weight.
+ */
+uint16_t PackedColor::Weight(float fraction) {
+  return std::max(0, std::min(one, (int)(fraction*one + 0.5f)));
+};
+
+// Blends one channel, where the weight of "to" is w out of 256.
+static inline color_t LerpChannel(color_t from, color_t to, int w, int shift) {
+  color_t a = (from >> shift) & 0xFF;
+  color_t b = (to >> shift) & 0xFF;
+  return ((a*(PackedColor::one - w) + b*w) >> 8) << shift;
+}
+
+static inline color_t LerpScalar(color_t from, color_t to, int w) {
+  return opaque | LerpChannel(from, to, w, 16) | LerpChannel(from, to, w, 8) |
+         LerpChannel(from, to, w, 0);
+}
+
+#ifdef __SSE2__
+// Blends two colours held as eight 16-bit channels, using a weight for
+// each channel.
+static inline __m128i LerpHalf(__m128i from, __m128i to, __m128i weights) {
+  __m128i rest = _mm_sub_epi16(_mm_set1_epi16(PackedColor::one), weights);
+  __m128i sum = _mm_add_epi16(_mm_mullo_epi16(from, rest),
+                              _mm_mullo_epi16(to, weights));
+  return _mm_srli_epi16(sum, 8);
+}
+
+// Blends four colours at once, with one weight for each colour.
+static inline __m128i Lerp4(__m128i from, __m128i to, const uint16_t* w) {
+  __m128i zero = _mm_setzero_si128();
+  __m128i low_weights = _mm_set_epi16(w[1], w[1], w[1], w[1],
+                                      w[0], w[0], w[0], w[0]);
+  __m128i high_weights = _mm_set_epi16(w[3], w[3], w[3], w[3],
+                                       w[2], w[2], w[2], w[2]);
+  __m128i low = LerpHalf(_mm_unpacklo_epi8(from, zero),
+                         _mm_unpacklo_epi8(to, zero), low_weights);
+  __m128i high = LerpHalf(_mm_unpackhi_epi8(from, zero),
+                          _mm_unpackhi_epi8(to, zero), high_weights);
+  return _mm_or_si128(_mm_packus_epi16(low, high),
+                      _mm_set1_epi32((int)opaque));
+}
+#endif
+
+/** Blends an array of colours toward one colour, each by its own amount.
+ *
+ * @param from - The colours to start from
+ * @param to - The colour to blend toward
+ * @param weights - How much of "to" each result gets, out of 256
+ * @param out - Where to put the results, which may be the same as "from"
+ * @param n - The number of colours
+ */
+void PackedColor::Lerp(const color_t* from, color_t to, const uint16_t* weights,
+                       color_t* out, int n) {
+  int i = 0;
+#ifdef __SSE2__
+  __m128i target = _mm_set1_epi32((int)to);
+  for (; i+4 <= n; i += 4) {
+    __m128i in = _mm_loadu_si128((const __m128i*)(from + i));
+    _mm_storeu_si128((__m128i*)(out + i), Lerp4(in, target, weights + i));
+  }
+#endif
+  for (; i<n; i++) out[i] = LerpScalar(from[i], to, weights[i]);
+};
+
+/** Blends an array of colours toward one colour, all by the same amount.
+ *
+ * This is what the aiming overlay uses to tint the tiles in range.
+ */
+void PackedColor::Mix(const color_t* from, color_t to, uint16_t weight,
+                      color_t* out, int n) {
+  int i = 0;
+#ifdef __SSE2__
+  const uint16_t weights[4] = {weight, weight, weight, weight};
+  __m128i target = _mm_set1_epi32((int)to);
+  for (; i+4 <= n; i += 4) {
+    __m128i in = _mm_loadu_si128((const __m128i*)(from + i));
+    _mm_storeu_si128((__m128i*)(out + i), Lerp4(in, target, weights));
+  }
+#endif
+  for (; i<n; i++) out[i] = LerpScalar(from[i], to, weight);
+};
+
+/** Darkens an array of colours.
+ *
+ * @param scale - The brightness to keep, out of 256
+ */
+void PackedColor::Scale(const color_t* in, uint16_t scale, color_t* out,
+                        int n) {
+  // Scaling is blending toward black.
+  Mix(in, opaque, one - scale, out, n);
+};
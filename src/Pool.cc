@@ -0,0 +1,71 @@
+/**
+ *  \brief
+ *
+ *  Copyright (C) 2017  Chaos-Dev
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Pool.h"
+
+#include <algorithm>
+
+/** Creates an empty pool.  No memory is allocated until it is used.
+ *
+ * @param block_size - How many bytes to allocate at a time
+ */
+Pool::Pool(size_t block_size)
+    : block_size(block_size), current(0), used(0) {
+};
+
+Pool::~Pool() {
+  Release();
+};
+
+/** Finds room for an object, moving on to the next block if it doesn't fit.
+ *
+ * The blocks come from new[], which aligns them for any standard type, so
+ * only the offset into a block has to be aligned.
+ */
+void* Pool::Allocate(size_t size, size_t align) {
+  while (current < blocks.size()) {
+    size_t start = (used + align-1) / align * align;
+    if (start + size <= blocks[current].size) {
+      used = start + size;
+      return blocks[current].data.get() + start;
+    }
+    current++;
+    used = 0;
+  }
+  // Every block is full, so add one that's large enough.
+  Block block;
+  block.size = std::max(block_size, size);
+  block.data.reset(new char[block.size]);
+  blocks.push_back(std::move(block));
+  current = blocks.size()-1;
+  used = size;
+  return blocks[current].data.get();
+};
+
+/** Destroys every object in the pool, newest first.
+ *
+ * The blocks are kept, so the next level can reuse them.
+ */
+void Pool::Release() {
+  for (auto it = cleanups.rbegin(); it != cleanups.rend(); ++it)
+    it->destroy(it->object);
+  cleanups.clear();
+  current = 0;
+  used = 0;
+};
@@ -18,6 +18,7 @@
 
 #include "River.h"
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 
@@ -88,6 +89,26 @@ float River::GetVelocity(int x, int y) {
   }
 };
 
+/** Finds the speed of the current anywhere in the river, as a fraction of
+ * the fastest speed at that point along the river.
+ *
+ * Unlike GetVelocity, this works between tiles, by interpolating the shape
+ * and width of the river between neighbouring columns.
+ *
+ * @param x - The distance along the river, in tiles
+ * @param y - The distance across the river, in tiles
+ * @return 1 in the middle of the river, down to 0 at the banks and beyond
+ */
+float River::GetRelativeVelocity(float x, float y) {
+  x = std::max(0.0f, std::min(x, length-1.0f));
+  int i = std::min((int)x, length-2);
+  float t = x - i;
+  float center = shape[i]*(1-t) + shape[i+1]*t;
+  float half_width = (width[i]*(1-t) + width[i+1]*t)/2.0;
+  float rescaled = (y - center)/half_width;
+  return std::max(0.0f, 1.0f - rescaled*rescaled);
+};
+
 bool River::isBeach(int x, int y) {
   int i = (int)x;
   float rescaled = std::abs(y - shape[i])/(width[i]/2.0);
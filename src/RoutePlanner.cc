@@ -0,0 +1,324 @@
+/**
+ *  \brief
+ *
+ *  Copyright (C) 2017  Chaos-Dev
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "RoutePlanner.h"
+
+#include <functional>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+
+RoutePlanner::RoutePlanner() : map(nullptr), goal_x(0) {
+};
+
+/** Discards everything known about the previous level and plans the new one.
+ *
+ * The backwards search is run here, while the level loads, so the first
+ * route requested doesn't stall a frame.
+ *
+ * @param map - The new level
+ * @param goal_x - Reaching any x coordinate past this ends the level
+ */
+void RoutePlanner::Reset(const Map* map, int goal_x) {
+  this->map = map;
+  this->goal_x = goal_x;
+  route.clear();
+  route_moves.clear();
+  Build();
+};
+
+/** Converts a move number (0-8) into a direction.
+ */
+void RoutePlanner::GetMove(int move, int* dx, int* dy) {
+  *dx = move%3 - 1;
+  *dy = move/3 - 1;
+};
+
+int RoutePlanner::GetState(int x, int y) const {
+  if (x < 0 || y < 0 || x >= map->width || y >= map->height) return NONE;
+  return state_of[x + y*map->width];
+};
+
+/** Finds the cost of reaching the end of the level from every water tile.
+ *
+ * Every move from every water tile is worked out with the drift tables, and
+ * then a Dijkstra search is run backwards from the end of the level.
+ */
+void RoutePlanner::Build() {
+  state_of.assign(map->width*map->height, NONE);
+  positions.clear();
+  for (int x=0; x<map->width; x++) {
+    for (int y=0; y<map->height; y++) {
+      if (map->isWater(x,y)) {
+        state_of[x + y*map->width] = positions.size();
+        positions.push_back(Position(x,y));
+      }
+    }
+  }
+
+  // Work out where every move goes, and count the moves into each state.
+  int num_states = positions.size();
+  edges.resize(num_states*num_moves);
+  std::vector<int> incoming_start(num_states+1, 0);
+  std::vector<Edge> goal_edges;
+  for (int state=0; state<num_states; state++) {
+    Position from = positions[state];
+    for (int move=0; move<num_moves; move++) {
+      Edge& edge = edges[state*num_moves + move];
+      edge.target = NONE;
+      edge.cost = infinity;
+      int dx, dy;
+      GetMove(move, &dx, &dy);
+      if (!map->isWater(from.x+dx, from.y+dy)) continue;
+      Position to = map->GetDrift(from.x, from.y, from.x+dx, from.y+dy);
+      edge.cost = 1.0 + rock_cost*map->CountRocks(from.x, from.y, to.x, to.y);
+      if (to.x > goal_x) {
+        edge.target = GOAL;
+      } else {
+        edge.target = GetState(to.x, to.y);
+        if (edge.target >= 0) incoming_start[edge.target+1]++;
+      }
+    }
+  }
+
+  // Store the moves into each state contiguously.
+  for (int state=0; state<num_states; state++)
+    incoming_start[state+1] += incoming_start[state];
+  std::vector<int> incoming(incoming_start[num_states]);
+  std::vector<int> fill(incoming_start.begin(), incoming_start.end()-1);
+  for (int i=0; i<num_states*num_moves; i++) {
+    if (edges[i].target >= 0) incoming[fill[edges[i].target]++] = i;
+  }
+
+  // Search backwards from the end of the level.
+  typedef std::pair<float, int> Entry;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry> > open;
+  cost_to_go.assign(num_states, infinity);
+  best_move.assign(num_states, NONE);
+  for (int i=0; i<num_states*num_moves; i++) {
+    int state = i/num_moves;
+    if (edges[i].target == GOAL && edges[i].cost < cost_to_go[state]) {
+      cost_to_go[state] = edges[i].cost;
+      best_move[state] = i%num_moves;
+      open.push(Entry(edges[i].cost, state));
+    }
+  }
+  while (!open.empty()) {
+    Entry entry = open.top();
+    open.pop();
+    int state = entry.second;
+    if (entry.first > cost_to_go[state]) continue;
+    for (int i=incoming_start[state]; i<incoming_start[state+1]; i++) {
+      int edge = incoming[i];
+      int from = edge/num_moves;
+      float cost = cost_to_go[state] + edges[edge].cost;
+      if (cost < cost_to_go[from]) {
+        cost_to_go[from] = cost;
+        best_move[from] = edge%num_moves;
+        open.push(Entry(cost, from));
+      }
+    }
+  }
+};
+
+/** Finds the penalty for ending a turn at a position.
+ */
+float RoutePlanner::ThreatAt(const std::vector<Threat>& threats,
+                             Position position) const {
+  float cost = 0.0;
+  for (const Threat& threat : threats) {
+    int dx = threat.x - position.x;
+    int dy = threat.y - position.y;
+    if (dx*dx + dy*dy <= threat.range*threat.range) cost += threat_cost;
+  }
+  return cost;
+};
+
+/** Finds the monster penalty along the stored route, starting at a step.
+ */
+float RoutePlanner::RouteThreat(const std::vector<Threat>& threats,
+                                int start) const {
+  float cost = 0.0;
+  for (int i=start+1; i<(int)route.size() && i<=start+threat_turns; i++)
+    cost += ThreatAt(threats, route[i]);
+  return cost;
+};
+
+/** Finds the best route while taking monsters into account.
+ *
+ * This is an A* search over (tile, turn) pairs for the next few turns.  Once
+ * a route is that many turns long, monsters are ignored, so the rest of the
+ * cost is exactly the stored cost to go, which is also the heuristic.  The
+ * search therefore only spreads out where monsters are in the way.
+ */
+void RoutePlanner::Search(int start, const std::vector<Threat>& threats) {
+  struct Node {
+    int state, turn, parent, move;
+    float cost;
+  };
+  typedef std::pair<float, int> Entry;
+  std::vector<Node> nodes;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry> > open;
+  std::unordered_map<long long, float> best_cost;
+
+  nodes.push_back(Node{start, 0, NONE, NONE, 0.0});
+  open.push(Entry(cost_to_go[start], 0));
+  int last = NONE;
+  while (!open.empty()) {
+    int index = open.top().second;
+    open.pop();
+    Node node = nodes[index];
+    if (node.state == GOAL || node.turn == threat_turns) {
+      last = index;
+      break;
+    }
+    long long key = (long long)node.state*(threat_turns+1) + node.turn;
+    auto found = best_cost.find(key);
+    if (found != best_cost.end() && found->second < node.cost) continue;
+
+    for (int move=0; move<num_moves; move++) {
+      const Edge& edge = edges[node.state*num_moves + move];
+      if (edge.target == NONE) continue;
+      float cost = node.cost + edge.cost;
+      if (edge.target == GOAL) {
+        nodes.push_back(Node{GOAL, node.turn+1, index, move, cost});
+        open.push(Entry(cost, nodes.size()-1));
+        continue;
+      }
+      if (cost_to_go[edge.target] >= infinity) continue;
+      cost += ThreatAt(threats, positions[edge.target]);
+      long long next_key = (long long)edge.target*(threat_turns+1) + node.turn+1;
+      auto next = best_cost.find(next_key);
+      if (next != best_cost.end() && next->second <= cost) continue;
+      best_cost[next_key] = cost;
+      nodes.push_back(Node{edge.target, node.turn+1, index, move, cost});
+      open.push(Entry(cost + cost_to_go[edge.target], nodes.size()-1));
+    }
+  }
+
+  // Walk back up the search tree, then follow the stored policy to the end.
+  route.clear();
+  route_moves.clear();
+  if (last == NONE) return;
+  std::vector<int> moves;
+  for (int index=last; nodes[index].parent != NONE; index=nodes[index].parent)
+    moves.push_back(nodes[index].move);
+  route.push_back(positions[start]);
+  int state = start;
+  for (auto move=moves.rbegin(); move!=moves.rend(); ++move) {
+    int dx, dy;
+    GetMove(*move, &dx, &dy);
+    Position from = route.back();
+    route.push_back(map->GetDrift(from.x, from.y, from.x+dx, from.y+dy));
+    route_moves.push_back(*move);
+    state = edges[state*num_moves + *move].target;
+  }
+  if (state != GOAL) FollowPolicy(state);
+};
+
+/** Extends the route by following the best moves ignoring monsters.
+ */
+void RoutePlanner::FollowPolicy(int state) {
+  for (int i=0; state >= 0 && i<(int)positions.size(); i++) {
+    int move = best_move[state];
+    if (move == NONE) return;
+    int dx, dy;
+    GetMove(move, &dx, &dy);
+    Position from = positions[state];
+    route.push_back(map->GetDrift(from.x, from.y, from.x+dx, from.y+dy));
+    route_moves.push_back(move);
+    state = edges[state*num_moves + move].target;
+  }
+};
+
+/** Keeps the previous route if the raft is on it or one move away from it.
+ *
+ * The raft can rejoin the route at any of its next few steps, with one
+ * move.  If that is as fast as the river allows from here, and the route
+ * is clear of monsters, it cannot be improved on.
+ *
+ * @param start - The raft's state
+ * @return True if the route was kept, starting from the raft
+ */
+bool RoutePlanner::Rejoin(int start, const std::vector<Threat>& threats) {
+  for (int i=0; i<(int)route.size() && i<=threat_turns; i++) {
+    int state = GetState(route[i].x, route[i].y);
+    if (state < 0) break;
+    int first_move = NONE;
+    float cost = 0.0;
+    if (state != start) {
+      for (int move=0; move<num_moves; move++) {
+        const Edge& edge = edges[start*num_moves + move];
+        if (edge.target == state && (first_move == NONE || edge.cost < cost)) {
+          first_move = move;
+          cost = edge.cost;
+        }
+      }
+      if (first_move == NONE) continue;
+    }
+    for (int j=i; j<(int)route_moves.size() && state >= 0; j++) {
+      cost += edges[state*num_moves + route_moves[j]].cost;
+      state = edges[state*num_moves + route_moves[j]].target;
+    }
+    if (cost > cost_to_go[start] + 1e-3) continue;
+
+    route.erase(route.begin(), route.begin()+i);
+    route_moves.erase(route_moves.begin(), route_moves.begin()+i);
+    if (first_move != NONE) {
+      route.insert(route.begin(), positions[start]);
+      route_moves.insert(route_moves.begin(), first_move);
+    }
+    return RouteThreat(threats, 0) == 0.0;
+  }
+  return false;
+};
+
+/** Finds the best route from a position to the end of the level.
+ *
+ * The previous route is kept when the raft is on it or next to it, and it
+ * is still the best way.  Otherwise a new one is searched for.
+ *
+ * @param x - The x coordinate of the raft
+ * @param y - The y coordinate of the raft
+ * @param threats - The monsters that might shoot at the raft
+ * @return True if a route was found
+ */
+bool RoutePlanner::Plan(int x, int y, const std::vector<Threat>& threats) {
+  if (!map) return false;
+  int start = GetState(x, y);
+  if (start == NONE || cost_to_go[start] >= infinity) {
+    route.clear();
+    route_moves.clear();
+    return false;
+  }
+  if (Rejoin(start, threats)) return true;
+
+  Search(start, threats);
+  return !route.empty();
+};
+
+/** Finds the next move along the current route.
+ *
+ * @return False if the position isn't the start of the route.
+ */
+bool RoutePlanner::NextMove(int x, int y, int* dx, int* dy) const {
+  if (route_moves.empty() || route[0].x != x || route[0].y != y) return false;
+  GetMove(route_moves[0], dx, dy);
+  return true;
+};
@@ -0,0 +1,83 @@
+/**
+ *  \brief
+ *
+ *  Copyright (C) 2017  Chaos-Dev
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ThreatPass.h"
+
+#include "Actor.h"
+#include "ActorStore.h"
+#include "Ballistics.h"
+#include "Engine.h"
+
+/** Checks the range of every monster against the target in one pass.
+ *
+ * This gives the same answers as Attacker::InRange.  The line of fire is
+ * only checked for the monsters that would otherwise take the shot.
+ *
+ * @param store - The actors on the level.  Its ai set holds the monsters
+ *                about to take their turns.
+ * @param target - The actor they are shooting at, i.e. the player.
+ */
+void ThreatPass::Update(const ActorStore& store, Actor* target) {
+  int count = store.ai.Size();
+  monsters.resize(count);
+  positions.resize(2*count);
+  reach2.resize(count);
+  max_range.resize(count);
+  attack.resize(count);
+  distance2.resize(count);
+  in_range.resize(count);
+
+  // The map is far smaller than 32768 tiles across, so the positions fit
+  // in 16 bits.
+  for (int i=0; i<count; i++) {
+    int monster = store.ai[i];
+    monsters[i] = store.actors[monster];
+    positions[2*i] = store.x[monster];
+    positions[2*i+1] = store.y[monster];
+    max_range[i] = store.max_range[monster];
+    attack[i] = store.attack[monster];
+    reach2[i] = Ballistics::Reach2(max_range[i]);
+  }
+
+  Ballistics::CheckRanges(positions.data(), reach2.data(), max_range.data(),
+                          attack.data(), count, target->x, target->y,
+                          target->attacker != nullptr,
+                          target->attacker ? target->GetStats().dodge : 0,
+                          distance2.data(), in_range.data());
+
+  for (int i=0; i<count; i++) {
+    // Rocks and walls block the shot.
+    if (in_range[i] &&
+        !engine.fov->LineOfFire(*engine.map, positions[2*i], positions[2*i+1],
+                                target->x, target->y))
+      in_range[i] = false;
+  }
+};
+
+/** Looks up whether a monster can shoot at the target this turn.
+ *
+ * Monsters that were added or moved in the ai set since the pass fall back
+ * to checking on their own.
+ */
+bool ThreatPass::InRange(Actor* monster, Actor* target) const {
+  int i = engine.actor_store->ai.IndexOf(monster->entity);
+  if (i >= 0 && i < int(monsters.size()) && monsters[i] == monster)
+    return in_range[i];
+  return monster->attacker->InRange(monster, target);
+};
@@ -0,0 +1,92 @@
+/**
+ *  \brief
+ *
+ *  Copyright (C) 2017  Chaos-Dev
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+#include "CombatDice.h"
+
+/** Checks the moments of the combat dice on a fixed seed.
+ *
+ *  The normal rolls should have the requested mean and spread, with no
+ *  skew and the kurtosis of a normal distribution.  The uniform rolls
+ *  should stay in [0, 1) and fill equal bins equally, which is checked
+ *  with a chi-squared test.
+ */
+
+static int failures = 0;
+
+static void Check(const char* name, double value, double expected,
+                  double tolerance) {
+  bool ok = std::fabs(value - expected) <= tolerance;
+  std::printf("%-20s %10.5f (expected %g +/- %g)%s\n", name, value, expected,
+              tolerance, ok ? "" : "  FAILED");
+  if (!ok) failures++;
+}
+
+static void CheckNormal(CombatDice& dice, int n) {
+  const double mean = 10.0, stddev = 3.0;
+  double sum = 0, sum2 = 0, sum3 = 0, sum4 = 0;
+  for (int i=0; i<n; i++) {
+    double z = (dice.Normal(mean, stddev) - mean)/stddev;
+    sum += z; sum2 += z*z; sum3 += z*z*z; sum4 += z*z*z*z;
+  }
+  double m = sum/n;
+  double var = sum2/n - m*m;
+  Check("normal mean", mean + stddev*m, mean, 0.01);
+  Check("normal stddev", stddev*std::sqrt(var), stddev, 0.01);
+  Check("normal skewness", sum3/n, 0.0, 0.01);
+  Check("normal kurtosis", sum4/n, 3.0, 0.03);
+}
+
+static void CheckUniform(CombatDice& dice, int n) {
+  const int bins = 64;
+  int counts[bins] = {0};
+  double sum = 0, sum2 = 0;
+  float lowest = 1, highest = 0;
+  for (int i=0; i<n; i++) {
+    float u = dice.Uniform();
+    lowest = std::fmin(lowest, u);
+    highest = std::fmax(highest, u);
+    sum += u; sum2 += u*u;
+    counts[std::min(bins - 1, int(u*bins))]++;
+  }
+  double m = sum/n;
+  Check("uniform mean", m, 0.5, 0.002);
+  Check("uniform variance", sum2/n - m*m, 1.0/12, 0.001);
+  Check("uniform lowest", lowest, 0.0, 0.001);
+  if (highest >= 1.0f) {
+    std::printf("uniform roll of 1 or more  FAILED\n");
+    failures++;
+  }
+  // With 63 degrees of freedom, chi-squared is below 98 in 99.7% of runs.
+  double expected = double(n)/bins, chi2 = 0;
+  for (int i=0; i<bins; i++)
+    chi2 += (counts[i] - expected)*(counts[i] - expected)/expected;
+  Check("uniform chi-squared", chi2, 63.0, 35.0);
+}
+
+int main() {
+  CombatDice dice;
+  dice.Seed(12345);
+  CheckNormal(dice, 1000000);
+  CheckUniform(dice, 1000000);
+  return failures == 0 ? 0 : 1;
+}
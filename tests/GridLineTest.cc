@@ -0,0 +1,173 @@
+/**
+ *  \brief
+ *
+ *  Copyright (C) 2017  Chaos-Dev
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "GridLine.h"
+
+/** Checks the supercover line walk that the raft's rock sweep is built on.
+ *
+ *  For lines in every direction, short and very long, the walk must:
+ *  end on the final tile, never visit a tile twice or the starting tile,
+ *  step only to neighbouring tiles, and on a diagonal step have visited
+ *  both tiles beside it.  It must visit every tile whose inside the line
+ *  crosses, and no tile the line misses.  Rocks are then scattered over a
+ *  grid, and every rock the line crosses must be reported as a hit, and
+ *  nothing else.
+ */
+
+typedef std::pair<int, int> Tile;
+
+static long failures = 0;
+
+static void Fail(const char* what, int x0, int y0, int x1, int y1) {
+  if (failures++ < 10) {
+    std::printf("%s: (%d,%d) to (%d,%d)\n", what, x0, y0, x1, y1);
+  }
+}
+
+static std::vector<Tile> Walk(int x0, int y0, int x1, int y1) {
+  std::vector<Tile> tiles;
+  GridLine::Supercover(x0, y0, x1, y1, [&](int x, int y) {
+    tiles.push_back(Tile(x, y));
+  });
+  return tiles;
+}
+
+// Twice the distance of the centre of a tile from the line, scaled by the
+// line's length, against the furthest a touching tile's centre can be.
+static long long Offset(int x0, int y0, int x1, int y1, int x, int y) {
+  long long cross = (long long)(x - x0)*(y1 - y0) -
+                    (long long)(y - y0)*(x1 - x0);
+  return 2*std::abs(cross) - (std::abs(x1 - x0) + std::abs(y1 - y0));
+}
+
+static void CheckPath(int x0, int y0, int x1, int y1, bool check_cover) {
+  std::vector<Tile> tiles = Walk(x0, y0, x1, y1);
+  int dx = std::abs(x1 - x0), dy = std::abs(y1 - y0);
+  if (x0 == x1 && y0 == y1) {
+    if (!tiles.empty()) Fail("visited tiles without moving", x0, y0, x1, y1);
+    return;
+  }
+  if (tiles.empty() || tiles.back() != Tile(x1, y1)) {
+    Fail("didn't end on the final tile", x0, y0, x1, y1);
+    return;
+  }
+  if ((int)tiles.size() < std::max(dx, dy) ||
+      (int)tiles.size() > dx + dy + std::min(dx, dy)) {
+    Fail("visited the wrong number of tiles", x0, y0, x1, y1);
+  }
+
+  std::set<Tile> seen(tiles.begin(), tiles.end());
+  if (seen.size() != tiles.size() || seen.count(Tile(x0, y0))) {
+    Fail("visited a tile twice", x0, y0, x1, y1);
+  }
+  seen.insert(Tile(x0, y0));
+  Tile from(x0, y0);
+  for (const Tile& to : tiles) {
+    int step_x = std::abs(to.first - from.first);
+    int step_y = std::abs(to.second - from.second);
+    if (step_x > 1 || step_y > 1) {
+      Fail("jumped over a tile", x0, y0, x1, y1);
+    } else if (step_x == 1 && step_y == 1 &&
+               (!seen.count(Tile(from.first, to.second)) ||
+                !seen.count(Tile(to.first, from.second)))) {
+      Fail("slipped past a corner", x0, y0, x1, y1);
+    }
+    if (Offset(x0, y0, x1, y1, to.first, to.second) > 0) {
+      Fail("visited a tile off the line", x0, y0, x1, y1);
+    }
+    from = to;
+  }
+
+  if (!check_cover) return;
+  for (int x=std::min(x0, x1); x<=std::max(x0, x1); x++) {
+    for (int y=std::min(y0, y1); y<=std::max(y0, y1); y++) {
+      if (Offset(x0, y0, x1, y1, x, y) < 0 && !seen.count(Tile(x, y))) {
+        Fail("missed a tile under the line", x0, y0, x1, y1);
+      }
+    }
+  }
+}
+
+static void CheckRocks(const std::vector<bool>& rocks, int width,
+                       int x0, int y0, int x1, int y1) {
+  std::vector<Tile> hits;
+  GridLine::Supercover(x0, y0, x1, y1, [&](int x, int y) {
+    if (rocks[x + y*width]) hits.push_back(Tile(x, y));
+  });
+  for (const Tile& hit : hits) {
+    if (!rocks[hit.first + hit.second*width]) {
+      Fail("hit something that isn't a rock", x0, y0, x1, y1);
+    }
+  }
+  std::set<Tile> hit_set(hits.begin(), hits.end());
+  for (int x=std::min(x0, x1); x<=std::max(x0, x1); x++) {
+    for (int y=std::min(y0, y1); y<=std::max(y0, y1); y++) {
+      if ((x != x0 || y != y0) && rocks[x + y*width] &&
+          Offset(x0, y0, x1, y1, x, y) <= 0 && !hit_set.count(Tile(x, y))) {
+        Fail("missed a rock under the line", x0, y0, x1, y1);
+      }
+    }
+  }
+}
+
+int main() {
+  // Every direction and length up to 12 tiles, from the origin.
+  for (int x1=-12; x1<=12; x1++) {
+    for (int y1=-12; y1<=12; y1++) CheckPath(0, 0, x1, y1, true);
+  }
+
+  // Very fast currents, far past the edge of any level.
+  std::mt19937 rng(27);
+  std::uniform_int_distribution<int> huge(-20000, 20000);
+  for (int i=0; i<50; i++) {
+    CheckPath(huge(rng), huge(rng), huge(rng), huge(rng), false);
+  }
+
+  // An exact diagonal between two rocks must hit both of them.
+  int corner_hits = 0;
+  GridLine::Supercover(0, 0, 1, 1, [&](int x, int y) {
+    if ((x == 1 && y == 0) || (x == 0 && y == 1)) corner_hits++;
+  });
+  if (corner_hits != 2) Fail("slipped between two rocks", 0, 0, 1, 1);
+
+  const int width = 64;
+  std::vector<bool> rocks(width*width);
+  std::bernoulli_distribution rock(0.2);
+  for (int i=0; i<width*width; i++) rocks[i] = rock(rng);
+  std::uniform_int_distribution<int> coord(0, width - 1);
+  for (int i=0; i<20000; i++) {
+    CheckRocks(rocks, width, coord(rng), coord(rng), coord(rng), coord(rng));
+  }
+
+  if (failures) {
+    std::printf("%ld failures\n", failures);
+    return 1;
+  }
+  std::printf("All line walks passed\n");
+  return 0;
+}
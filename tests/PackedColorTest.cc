@@ -0,0 +1,75 @@
+/**
+ *  \brief
+ *
+ *  Copyright (C) 2017  Chaos-Dev
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstdio>
+#include <vector>
+
+#include "PackedColor.h"
+
+/** Checks the packed colour blends against a plain per-channel formula.
+ *
+ *  Lerp, Mix and Scale are all checked.  With SSE2, four colours are
+ *  blended at once and any left over are done one at a time.  Every weight
+ *  is tried against every channel value of the source and a spread of
+ *  targets, with an odd length so the leftover colours are covered too.
+ *  The results must match bit for bit.
+ */
+
+static color_t Reference(color_t from, color_t to, int w) {
+  color_t result = 0xFF000000;
+  for (int shift=0; shift<24; shift+=8) {
+    color_t a = (from >> shift) & 0xFF;
+    color_t b = (to >> shift) & 0xFF;
+    result |= ((a*(PackedColor::one - w) + b*w) >> 8) << shift;
+  }
+  return result;
+}
+
+int main() {
+  const int n = 259;
+  std::vector<color_t> from(n), out(n);
+  std::vector<uint16_t> weights(n);
+  for (int i=0; i<n; i++) {
+    color_t c = i & 0xFF;
+    from[i] = (c << 24) | (c << 16) | ((255 - c) << 8) | ((c*37) & 0xFF);
+  }
+
+  long checked = 0, failures = 0;
+  for (int b=0; b<256; b+=15) {
+    color_t to = (b << 16) | (((b*91) & 0xFF) << 8) | (255 - b);
+    for (int w=0; w<=PackedColor::one; w++) {
+      for (int i=0; i<n; i++) weights[i] = (w + i) % (PackedColor::one + 1);
+      PackedColor::Lerp(from.data(), to, weights.data(), out.data(), n);
+      for (int i=0; i<n; i++, checked++) {
+        if (out[i] != Reference(from[i], to, weights[i])) failures++;
+      }
+      PackedColor::Mix(from.data(), to, w, out.data(), n);
+      for (int i=0; i<n; i++, checked++) {
+        if (out[i] != Reference(from[i], to, w)) failures++;
+      }
+      PackedColor::Scale(from.data(), w, out.data(), n);
+      for (int i=0; i<n; i++, checked++) {
+        if (out[i] != Reference(from[i], 0, PackedColor::one - w)) failures++;
+      }
+    }
+  }
+
+  std::printf("%ld blends checked, %ld wrong\n", checked, failures);
+  return failures == 0 ? 0 : 1;
+}